@@ -0,0 +1,112 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "matrix.hpp"
+#include "thread_pool.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace throttle {
+namespace concurrency {
+
+// Run func on the pool; the result or the exception it throws ends up in the future.
+template <typename F>
+std::future<std::invoke_result_t<F &>> spawn_future(F func, thread_pool &pool = thread_pool::instance()) {
+  using result_type = std::invoke_result_t<F &>;
+
+  // packaged_task is move-only while pool tasks are std::function, hence the shared_ptr.
+  auto task = std::make_shared<std::packaged_task<result_type()>>(std::move(func));
+  auto res = task->get_future();
+  pool.submit([task] { (*task)(); });
+  return res;
+}
+
+// Awaiting this runs func on the pool and resumes the awaiting coroutine on the pool thread that finished it, with the
+// result of func or its exception.
+template <typename F> class pool_awaitable {
+public:
+  using result_type = std::invoke_result_t<F &>;
+
+private:
+  using storage_type = std::conditional_t<std::is_void_v<result_type>, bool, result_type>;
+
+  F                           m_func;
+  thread_pool                *m_pool;
+  std::optional<storage_type> m_result;
+  std::exception_ptr          m_error;
+
+public:
+  pool_awaitable(F func, thread_pool &pool) : m_func{std::move(func)}, m_pool{&pool} {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    m_pool->submit([this, handle] {
+      try {
+        if constexpr (std::is_void_v<result_type>) {
+          m_func();
+          m_result.emplace(true);
+        } else {
+          m_result.emplace(m_func());
+        }
+      } catch (...) {
+        m_error = std::current_exception();
+      }
+      handle.resume();
+    });
+  }
+
+  result_type await_resume() {
+    if (m_error) std::rethrow_exception(m_error);
+    if constexpr (!std::is_void_v<result_type>) return std::move(*m_result);
+  }
+};
+
+template <typename F> pool_awaitable<F> spawn_awaitable(F func, thread_pool &pool = thread_pool::instance()) {
+  return pool_awaitable<F>{std::move(func), pool};
+}
+
+} // namespace concurrency
+
+namespace linmath {
+
+// Asynchronous counterparts of determinant() and operator*. Operands are taken by value, so the caller is free to
+// reuse or destroy its matrices (or move them in) right after the call.
+
+template <typename M>
+auto determinant_async(M mat, concurrency::thread_pool &pool = concurrency::thread_pool::instance()) {
+  return concurrency::spawn_future([mat = std::move(mat)] { return mat.determinant(); }, pool);
+}
+
+template <typename M>
+auto multiply_async(M lhs, M rhs, concurrency::thread_pool &pool = concurrency::thread_pool::instance()) {
+  return concurrency::spawn_future([lhs = std::move(lhs), rhs = std::move(rhs)] { return lhs * rhs; }, pool);
+}
+
+template <typename M>
+auto co_determinant(M mat, concurrency::thread_pool &pool = concurrency::thread_pool::instance()) {
+  return concurrency::spawn_awaitable([mat = std::move(mat)] { return mat.determinant(); }, pool);
+}
+
+template <typename M>
+auto co_multiply(M lhs, M rhs, concurrency::thread_pool &pool = concurrency::thread_pool::instance()) {
+  return concurrency::spawn_awaitable([lhs = std::move(lhs), rhs = std::move(rhs)] { return lhs * rhs; }, pool);
+}
+
+} // namespace linmath
+} // namespace throttle
@@ -0,0 +1,143 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "isa.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace throttle {
+namespace linmath {
+namespace kernels {
+
+// Division by a fixed non-zero d of dividends that are known to be multiples of d. With d = 2^s * m and m odd,
+// x / d = (x >> s) * m^-1 modulo 2^w, where m^-1 is the inverse of m modulo 2^w. A shift and a multiplication are
+// much cheaper than an integer division, and unlike it they vectorize. The result is meaningless for other dividends.
+template <std::integral T> class exact_divisor {
+  using unsigned_type = std::make_unsigned_t<T>;
+  // Types narrower than unsigned would be promoted to int, where the wrapping multiplications are undefined.
+  using word = std::conditional_t<(sizeof(T) < sizeof(unsigned)), unsigned, unsigned_type>;
+
+  unsigned_type m_inverse;
+  int           m_shift;
+  bool          m_negative = false;
+
+public:
+  constexpr explicit exact_divisor(T d) {
+    unsigned_type magnitude = static_cast<unsigned_type>(d);
+    if constexpr (std::is_signed_v<T>) {
+      if (d < T{}) {
+        magnitude = static_cast<unsigned_type>(unsigned_type{} - magnitude);
+        m_negative = true;
+      }
+    }
+
+    m_shift = std::countr_zero(magnitude);
+    word odd = magnitude >> m_shift;
+
+    // Newton iteration doubles the number of correct low bits; odd * odd == 1 modulo 8 gives the first three.
+    word inverse = odd;
+    for (int bits = 3; bits < std::numeric_limits<unsigned_type>::digits; bits *= 2) {
+      inverse *= word{2} - odd * inverse;
+    }
+    m_inverse = static_cast<unsigned_type>(inverse);
+  }
+
+  constexpr T divide(T x) const {
+    auto quotient = static_cast<unsigned_type>(word{static_cast<unsigned_type>(x >> m_shift)} * m_inverse);
+    if (m_negative) quotient = static_cast<unsigned_type>(unsigned_type{} - quotient);
+    return static_cast<T>(quotient);
+  }
+};
+
+namespace detail {
+
+// Pivot search and row exchanges of Bareiss elimination. update(k, prev) overwrites the rows below k past column k with
+// (a[k][k] * a[i][j] - a[i][k] * a[k][j]) / prev, prev being the pivot of the step before.
+template <typename T, typename U> constexpr T bareiss_impl(T *a, std::size_t n, U update) {
+  bool negate = false;
+  T    prev{1};
+
+  for (std::size_t k = 0; k + 1 < n; ++k) {
+    std::size_t pivot_row = k;
+    while (pivot_row < n && a[pivot_row * n + k] == T{})
+      ++pivot_row;
+    if (pivot_row == n) return T{};
+
+    if (pivot_row != k) {
+      std::swap_ranges(a + k * n, a + (k + 1) * n, a + pivot_row * n);
+      negate = !negate;
+    }
+
+    update(k, prev);
+    prev = a[k * n + k];
+  }
+
+  T det = (n ? a[n * n - 1] : T{1});
+  return (negate ? static_cast<T>(T{} - det) : det);
+}
+
+} // namespace detail
+
+// Determinant of the n x n row-major buffer a by fraction-free (Bareiss) elimination, which overwrites it. Step k
+// divides every updated element by the pivot of step k - 1, which divides it exactly, so all divisions of a step go
+// through one exact_divisor. Rows below the pivot are updated independently on the pool, in constant evaluation one
+// after another. The products a[k][k] * a[i][j] have to fit in T, as with the plain elimination.
+template <std::integral T> constexpr T bareiss_determinant(T *a, std::size_t n) {
+  return detail::bareiss_impl(a, n, [a, n](std::size_t k, T prev) {
+    const T            *pivot = a + k * n;
+    const exact_divisor divisor{prev};
+    auto                eliminate = [a, pivot, k, n, divisor](std::size_t first, std::size_t last) {
+      // Locals, so that the compiler does not have to reload them after every store.
+      const T             a_kk = pivot[k];
+      const exact_divisor div = divisor;
+      for (std::size_t i = first; i < last; ++i) {
+        T      *row = a + i * n;
+        const T a_ik = row[k];
+        for (std::size_t j = k + 1; j < n; ++j) {
+          row[j] = div.divide(a_kk * row[j] - a_ik * pivot[j]);
+        }
+      }
+    };
+
+    if (std::is_constant_evaluated()) {
+      eliminate(k + 1, n);
+    } else {
+      concurrency::parallel_for(k + 1, n, concurrency::grain_for(n - k),
+                                [&eliminate](std::size_t first, std::size_t last) {
+                                  isa::dispatch([&] { eliminate(first, last); });
+                                });
+    }
+  });
+}
+
+// Same elimination for other exact rings, such as rationals, with plain divisions. Runs in order.
+template <typename T>
+requires(!std::integral<T> && !std::floating_point<T>)
+constexpr T bareiss_determinant(T *a, std::size_t n) {
+  return detail::bareiss_impl(a, n, [a, n](std::size_t k, const T &prev) {
+    for (std::size_t i = k + 1; i < n; ++i) {
+      for (std::size_t j = k + 1; j < n; ++j) {
+        a[i * n + j] = (a[k * n + k] * a[i * n + j] - a[i * n + k] * a[k * n + j]) / prev;
+      }
+    }
+  });
+}
+
+} // namespace kernels
+} // namespace linmath
+} // namespace throttle
@@ -10,11 +10,22 @@
 
 #pragma once
 
+#include "bareiss.hpp"
+#include "elementwise.hpp"
+#include "elimination.hpp"
 #include "equal.hpp"
+#include "isa.hpp"
+#include "layout.hpp"
+#include "pivot.hpp"
+#include "small_determinant.hpp"
+#include "summation.hpp"
+#include "thread_pool.hpp"
+#include "tile_kernels.hpp"
 #include "utility.hpp"
 #include "vector.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
@@ -43,9 +54,15 @@ concept models_ring = requires(T a, T b) {
   requires std::copyable<T>;
 };
 
-template <typename T>
+// Dense matrix in a single buffer. Layout decides the storage order; rows are always indexed with operator[] and
+// columns with col(), whichever of the two happens to be contiguous.
+template <typename T, matrix_layout Layout = row_major>
 requires models_ring<T>
 class contiguous_matrix {
+  template <typename U, matrix_layout L>
+  requires models_ring<U>
+  friend class contiguous_matrix;
+
 public:
   using value_type = T;
   using reference = T &;
@@ -53,6 +70,11 @@ public:
   using pointer = T *;
   using const_pointer = const T *;
   using size_type = typename std::size_t;
+  using layout_type = Layout;
+
+  static constexpr bool is_row_major = std::same_as<Layout, row_major>;
+  static constexpr bool is_column_major = std::same_as<Layout, column_major>;
+  static constexpr bool is_tiled = is_tiled_layout<Layout>::value;
 
 private:
   size_type m_cols = 0;
@@ -60,27 +82,69 @@ private:
 
   containers::vector<value_type> m_buffer;
 
+  constexpr contiguous_matrix(size_type rows, size_type cols, containers::vector<value_type> &&buffer)
+      : m_cols{cols}, m_rows{rows}, m_buffer{std::move(buffer)} {}
+
+  constexpr size_type offset(size_type row, size_type col) const { return Layout::offset(row, col, m_rows, m_cols); }
+
+  // Tile kernels run over whole tiles, so the padding of edge tiles has to stay zero.
+  constexpr void clear_padding() requires is_tiled {
+    constexpr size_type tile = Layout::tile_size;
+    for (size_type ti = 0; ti < tile_rows(); ++ti) {
+      for (size_type tj = 0; tj < tile_cols(); ++tj) {
+        size_type valid_rows = std::min(tile, m_rows - ti * tile), valid_cols = std::min(tile, m_cols - tj * tile);
+        if (valid_rows == tile && valid_cols == tile) continue;
+
+        pointer first = tile_data(ti, tj);
+        for (size_type i = 0; i < tile; ++i) {
+          size_type from = (i < valid_rows ? valid_cols : 0);
+          std::fill(first + i * tile + from, first + (i + 1) * tile, value_type{});
+        }
+      }
+    }
+  }
+
 public:
-  contiguous_matrix(size_type rows, size_type cols, value_type val = value_type{})
-      : m_cols{cols}, m_rows{rows}, m_buffer{cols * rows, val} {}
+  constexpr contiguous_matrix(size_type rows, size_type cols, value_type val = value_type{})
+      : m_cols{cols}, m_rows{rows}, m_buffer{Layout::storage_size(rows, cols), val} {
+    if constexpr (is_tiled) {
+      if (val != value_type{}) clear_padding();
+    }
+  }
 
+  // Values are consumed in row order regardless of the layout, so that a literal reads the same for every layout. Use
+  // from_storage() to copy a buffer that is already in the target storage order.
   template <std::input_iterator it>
-  contiguous_matrix(size_type rows, size_type cols, it start, it finish) : contiguous_matrix{rows, cols} {
+  constexpr contiguous_matrix(size_type rows, size_type cols, it start, it finish) : contiguous_matrix{rows, cols} {
     size_type count = rows * cols;
-    std::copy_if(start, finish, m_buffer.begin(), [&count](const auto &) { return count && count--; });
+    if constexpr (is_row_major) {
+      std::copy_if(start, finish, m_buffer.begin(), [&count](const auto &) { return count && count--; });
+    } else {
+      for (size_type i = 0; i < count && start != finish; ++i, ++start) {
+        m_buffer[offset(i / cols, i % cols)] = *start;
+      }
+    }
   }
 
-  contiguous_matrix(size_type rows, size_type cols, std::initializer_list<value_type> list)
+  constexpr contiguous_matrix(size_type rows, size_type cols, std::initializer_list<value_type> list)
       : contiguous_matrix{rows, cols, list.begin(), list.end()} {}
 
-  static contiguous_matrix zero(size_type rows, size_type cols) { return contiguous_matrix{rows, cols}; }
+  template <std::input_iterator it>
+  static constexpr contiguous_matrix from_storage(size_type rows, size_type cols, it start, it finish) {
+    contiguous_matrix ret{rows, cols};
+    size_type         count = ret.m_buffer.size();
+    std::copy_if(start, finish, ret.m_buffer.begin(), [&count](const auto &) { return count && count--; });
+    if constexpr (is_tiled) ret.clear_padding();
+    return ret;
+  }
+
+  static constexpr contiguous_matrix zero(size_type rows, size_type cols) { return contiguous_matrix{rows, cols}; }
 
-  static contiguous_matrix unity(size_type size) {
+  static constexpr contiguous_matrix unity(size_type size) {
     contiguous_matrix ret{size, size};
-    auto              start = ret.begin();
 
-    for (size_type i = 0; i < size; ++i, start += size + 1) {
-      *start = 1;
+    for (size_type i = 0; i < size; ++i) {
+      ret.m_buffer[ret.offset(i, i)] = 1;
     }
 
     return ret;
@@ -92,23 +156,23 @@ private:
 
   public:
     proxy_row() = default;
-    proxy_row(pointer row, size_type n_cols) : m_row{row}, m_past_row{m_row + n_cols} {}
+    constexpr proxy_row(pointer row, size_type n_cols) : m_row{row}, m_past_row{m_row + n_cols} {}
 
     using iterator = utility::contiguous_iterator<value_type>;
     using const_iterator = utility::const_contiguous_iterator<value_type>;
 
-    reference       operator[](size_type index) { return m_row[index]; }
-    const_reference operator[](size_type index) const { return m_row[index]; }
+    constexpr reference       operator[](size_type index) { return m_row[index]; }
+    constexpr const_reference operator[](size_type index) const { return m_row[index]; }
 
-    iterator begin() { return iterator{m_row}; }
-    iterator end() { return iterator{m_past_row}; }
+    constexpr iterator begin() { return iterator{m_row}; }
+    constexpr iterator end() { return iterator{m_past_row}; }
 
-    const_iterator begin() const { return const_iterator{m_row}; }
-    const_iterator end() const { return const_iterator{m_past_row}; }
-    const_iterator cbegin() const { return const_iterator{m_row}; }
-    const_iterator cend() const { return const_iterator{m_past_row}; }
+    constexpr const_iterator begin() const { return const_iterator{m_row}; }
+    constexpr const_iterator end() const { return const_iterator{m_past_row}; }
+    constexpr const_iterator cbegin() const { return const_iterator{m_row}; }
+    constexpr const_iterator cend() const { return const_iterator{m_past_row}; }
 
-    size_type size() const { return m_past_row - m_row; }
+    constexpr size_type size() const { return m_past_row - m_row; }
   };
 
   class const_proxy_row {
@@ -116,56 +180,206 @@ private:
 
   public:
     const_proxy_row() = default;
-    const_proxy_row(const_pointer row, size_type n_cols) : m_row{row}, m_past_row{m_row + n_cols} {}
+    constexpr const_proxy_row(const_pointer row, size_type n_cols) : m_row{row}, m_past_row{m_row + n_cols} {}
 
     using iterator = utility::const_contiguous_iterator<value_type>;
     using const_iterator = iterator;
 
-    const_reference operator[](size_type index) const { return m_row[index]; }
-    iterator        begin() const { return iterator{m_row}; }
-    iterator        end() const { return iterator{m_past_row}; }
-    const_iterator  cbegin() const { return const_iterator{m_row}; }
-    const_iterator  cend() const { return const_iterator{m_past_row}; }
+    constexpr const_reference operator[](size_type index) const { return m_row[index]; }
+    constexpr iterator        begin() const { return iterator{m_row}; }
+    constexpr iterator        end() const { return iterator{m_past_row}; }
+    constexpr const_iterator  cbegin() const { return const_iterator{m_row}; }
+    constexpr const_iterator  cend() const { return const_iterator{m_past_row}; }
 
-    size_type size() const { return m_past_row - m_row; }
+    constexpr size_type size() const { return m_past_row - m_row; }
+  };
+
+  class strided_proxy_row {
+    pointer        m_first;
+    size_type      m_size;
+    std::ptrdiff_t m_stride;
+
+  public:
+    strided_proxy_row() = default;
+    constexpr strided_proxy_row(pointer first, size_type size, std::ptrdiff_t stride)
+        : m_first{first}, m_size{size}, m_stride{stride} {}
+
+    using iterator = utility::strided_iterator<value_type>;
+    using const_iterator = utility::strided_iterator<const value_type>;
+
+    constexpr reference       operator[](size_type index) { return m_first[index * m_stride]; }
+    constexpr const_reference operator[](size_type index) const { return m_first[index * m_stride]; }
+
+    constexpr iterator begin() { return iterator{m_first, m_stride}; }
+    constexpr iterator end() { return iterator{m_first + m_size * m_stride, m_stride}; }
+
+    constexpr const_iterator begin() const { return const_iterator{m_first, m_stride}; }
+    constexpr const_iterator end() const { return const_iterator{m_first + m_size * m_stride, m_stride}; }
+    constexpr const_iterator cbegin() const { return begin(); }
+    constexpr const_iterator cend() const { return end(); }
+
+    constexpr size_type size() const { return m_size; }
+  };
+
+  class const_strided_proxy_row {
+    const_pointer  m_first;
+    size_type      m_size;
+    std::ptrdiff_t m_stride;
+
+  public:
+    const_strided_proxy_row() = default;
+    constexpr const_strided_proxy_row(const_pointer first, size_type size, std::ptrdiff_t stride)
+        : m_first{first}, m_size{size}, m_stride{stride} {}
+
+    using iterator = utility::strided_iterator<const value_type>;
+    using const_iterator = iterator;
+
+    constexpr const_reference operator[](size_type index) const { return m_first[index * m_stride]; }
+    constexpr iterator        begin() const { return iterator{m_first, m_stride}; }
+    constexpr iterator        end() const { return iterator{m_first + m_size * m_stride, m_stride}; }
+    constexpr const_iterator  cbegin() const { return begin(); }
+    constexpr const_iterator  cend() const { return end(); }
+
+    constexpr size_type size() const { return m_size; }
   };
 
   static_assert(ranges::random_access_range<proxy_row>, "Proxy row is not a random access range");
   static_assert(ranges::random_access_range<const_proxy_row>, "Const proxy row is not a random access range");
+  static_assert(ranges::random_access_range<strided_proxy_row>, "Strided proxy row is not a random access range");
+  static_assert(ranges::random_access_range<const_strided_proxy_row>,
+                "Const strided proxy row is not a random access range");
+
+  // Rows and columns of a tiled matrix are neither contiguous nor evenly strided.
+  template <typename contiguous, typename strided, typename fallback>
+  using line_proxy = std::conditional_t<is_tiled, fallback, std::conditional_t<is_row_major, contiguous, strided>>;
+
+  using row_proxy = line_proxy<proxy_row, strided_proxy_row, layout_line<value_type, Layout>>;
+  using const_row_proxy = line_proxy<const_proxy_row, const_strided_proxy_row, layout_line<const value_type, Layout>>;
+  using col_proxy = line_proxy<strided_proxy_row, proxy_row, layout_line<value_type, Layout>>;
+  using const_col_proxy = line_proxy<const_strided_proxy_row, const_proxy_row, layout_line<const value_type, Layout>>;
 
 public:
-  proxy_row       operator[](size_type index) { return proxy_row{&m_buffer[index * m_cols], m_cols}; }
-  const_proxy_row operator[](size_type index) const { return const_proxy_row{&m_buffer[index * m_cols], m_cols}; }
+  constexpr row_proxy operator[](size_type index) {
+    if constexpr (is_tiled) return row_proxy{m_buffer.data(), index, 0, m_rows, m_cols, true};
+    else if constexpr (is_row_major) return row_proxy{&m_buffer[offset(index, 0)], m_cols};
+    else return row_proxy{&m_buffer[offset(index, 0)], m_cols, static_cast<std::ptrdiff_t>(m_rows)};
+  }
+
+  constexpr const_row_proxy operator[](size_type index) const {
+    if constexpr (is_tiled) return const_row_proxy{m_buffer.data(), index, 0, m_rows, m_cols, true};
+    else if constexpr (is_row_major) return const_row_proxy{&m_buffer[offset(index, 0)], m_cols};
+    else return const_row_proxy{&m_buffer[offset(index, 0)], m_cols, static_cast<std::ptrdiff_t>(m_rows)};
+  }
+
+  constexpr col_proxy col(size_type index) {
+    if constexpr (is_tiled) return col_proxy{m_buffer.data(), 0, index, m_rows, m_cols, false};
+    else if constexpr (is_column_major) return col_proxy{&m_buffer[offset(0, index)], m_rows};
+    else return col_proxy{&m_buffer[offset(0, index)], m_rows, static_cast<std::ptrdiff_t>(m_cols)};
+  }
+
+  constexpr const_col_proxy col(size_type index) const {
+    if constexpr (is_tiled) return const_col_proxy{m_buffer.data(), 0, index, m_rows, m_cols, false};
+    else if constexpr (is_column_major) return const_col_proxy{&m_buffer[offset(0, index)], m_rows};
+    else return const_col_proxy{&m_buffer[offset(0, index)], m_rows, static_cast<std::ptrdiff_t>(m_cols)};
+  }
 
-  size_type rows() const { return m_rows; }
-  size_type cols() const { return m_cols; }
-  bool      square() const { return rows() == cols(); }
+  // Tile access for tiled layouts. A tile is a dense tile_size x tile_size row-major block; tiles on the bottom and
+  // right edges are zero-padded.
+  constexpr size_type tile_rows() const requires is_tiled { return Layout::tile_count(m_rows); }
+  constexpr size_type tile_cols() const requires is_tiled { return Layout::tile_count(m_cols); }
 
-  contiguous_matrix &operator+=(const contiguous_matrix &other) {
+  constexpr pointer tile_data(size_type tile_row, size_type tile_col) requires is_tiled {
+    return m_buffer.data() + (tile_row * tile_cols() + tile_col) * Layout::tile_elements;
+  }
+
+  constexpr const_pointer tile_data(size_type tile_row, size_type tile_col) const requires is_tiled {
+    return m_buffer.data() + (tile_row * tile_cols() + tile_col) * Layout::tile_elements;
+  }
+
+  struct tile_ref {
+    size_type tile_row, tile_col;
+    pointer   data;
+  };
+
+  struct const_tile_ref {
+    size_type     tile_row, tile_col;
+    const_pointer data;
+  };
+
+  // All tiles in storage order, so that consecutive tiles are adjacent in memory.
+  auto tiles() requires is_tiled {
+    return ranges::views::iota(size_type{0}, tile_rows() * tile_cols()) |
+           ranges::views::transform([this, tcols = tile_cols()](size_type idx) {
+             return tile_ref{idx / tcols, idx % tcols, m_buffer.data() + idx * Layout::tile_elements};
+           });
+  }
+
+  auto tiles() const requires is_tiled {
+    return ranges::views::iota(size_type{0}, tile_rows() * tile_cols()) |
+           ranges::views::transform([this, tcols = tile_cols()](size_type idx) {
+             return const_tile_ref{idx / tcols, idx % tcols, m_buffer.data() + idx * Layout::tile_elements};
+           });
+  }
+
+  constexpr size_type rows() const { return m_rows; }
+  constexpr size_type cols() const { return m_cols; }
+  constexpr bool      square() const { return rows() == cols(); }
+
+  constexpr contiguous_matrix &operator+=(const contiguous_matrix &other) {
     if ((m_cols != other.m_cols) || (m_rows != other.m_rows)) throw std::runtime_error("Mismatched matrix sizes");
-    ranges::transform(m_buffer, other.m_buffer, m_buffer.begin(), std::plus<value_type>{});
+    kernels::zip(data(), data(), other.data(), m_buffer.size(), std::plus<value_type>{});
     return *this;
   }
 
-  contiguous_matrix &operator-=(const contiguous_matrix &other) {
+  constexpr contiguous_matrix &operator-=(const contiguous_matrix &other) {
     if ((m_cols != other.m_cols) || (m_rows != other.m_rows)) throw std::runtime_error("Mismatched matrix sizes");
-    ranges::transform(m_buffer, other.m_buffer, m_buffer.begin(), std::minus<value_type>{});
+    kernels::zip(data(), data(), other.data(), m_buffer.size(), std::minus<value_type>{});
     return *this;
   }
 
-  contiguous_matrix &operator*=(value_type rhs) {
-    ranges::actions::transform(m_buffer, [rhs](auto &&val) { return val * rhs; });
+  constexpr contiguous_matrix &operator*=(value_type rhs) {
+    kernels::map(data(), data(), m_buffer.size(), [rhs](const value_type &val) { return val * rhs; });
     return *this;
   }
 
-  contiguous_matrix &operator/=(value_type rhs) {
+  // Floating point division goes through the reciprocal, which may differ from exact division in the last bit. A
+  // subnormal divisor has no finite reciprocal, so it falls back to real division.
+  constexpr contiguous_matrix &operator/=(value_type rhs) {
     if (rhs == 0) throw std::invalid_argument("Division by zero");
-    ranges::actions::transform(m_buffer, [rhs](auto &&val) { return val / rhs; });
+    if constexpr (std::is_floating_point_v<value_type>) {
+      value_type reciprocal = value_type{1} / rhs;
+      if (std::isfinite(reciprocal)) return *this *= reciprocal;
+    }
+    kernels::map(data(), data(), m_buffer.size(), [rhs](const value_type &val) { return val / rhs; });
     return *this;
   }
 
-  bool equal(const contiguous_matrix &other,
-             const value_type        &precision = default_precision<value_type>::m_prec) const {
+  // Entrywise product.
+  constexpr contiguous_matrix &hadamard_assign(const contiguous_matrix &other) {
+    if ((m_cols != other.m_cols) || (m_rows != other.m_rows)) throw std::runtime_error("Mismatched matrix sizes");
+    kernels::zip(data(), data(), other.data(), m_buffer.size(), std::multiplies<value_type>{});
+    return *this;
+  }
+
+  // Replace every entry x with f(x). f may run concurrently on different entries.
+  template <std::invocable<const value_type &> F> constexpr contiguous_matrix &apply(F f) {
+    kernels::map(data(), data(), m_buffer.size(), f);
+    if constexpr (is_tiled) clear_padding();
+    return *this;
+  }
+
+  // Replace every entry x with f(x, y), where y is the entry of `other` in the same place.
+  template <std::invocable<const value_type &, const value_type &> F>
+  constexpr contiguous_matrix &apply(const contiguous_matrix &other, F f) {
+    if ((m_cols != other.m_cols) || (m_rows != other.m_rows)) throw std::runtime_error("Mismatched matrix sizes");
+    kernels::zip(data(), data(), other.data(), m_buffer.size(), f);
+    if constexpr (is_tiled) clear_padding();
+    return *this;
+  }
+
+  template <matrix_layout L>
+  constexpr bool equal(const contiguous_matrix<value_type, L> &other,
+                       const value_type &precision = default_precision<value_type>::m_prec) const {
     if ((rows() != other.rows()) || (cols() != other.cols())) return false;
     for (size_type i = 0; i < rows(); i++) {
       const auto first_row = (*this)[i];
@@ -177,8 +391,82 @@ public:
     return true;
   }
 
+  // Row of the largest magnitude element in column `col` among rows [minimum_row, rows()). Contiguous for column_major,
+  // strided otherwise.
+  std::pair<size_type, value_type> max_in_col_greater_eq(size_type col, size_type minimum_row) const {
+    const_pointer first = &m_buffer[offset(minimum_row, col)];
+    size_type     count = m_rows - minimum_row;
+    size_type     idx;
+
+    if constexpr (is_tiled) {
+      idx = kernels::detail::argmax_abs_impl<value_type>(
+          count, [this, minimum_row, col](size_type i) { return m_buffer[offset(minimum_row + i, col)]; });
+      return std::make_pair(minimum_row + idx, m_buffer[offset(minimum_row + idx, col)]);
+    }
+
+    if constexpr (is_column_major) idx = kernels::argmax_abs(first, count);
+    else idx = kernels::argmax_abs_strided(first, count, offset(1, 0) - offset(0, 0));
+
+    return std::make_pair(minimum_row + idx, first[offset(idx, 0) - offset(0, 0)]);
+  }
+
+  // Copy into another storage order. Walks the matrix in square blocks so that neither the reads nor the writes stride
+  // through the whole buffer.
+  template <matrix_layout L> constexpr contiguous_matrix<value_type, L> relayout() const {
+    if constexpr (std::same_as<L, Layout>) {
+      return *this;
+    } else {
+      contiguous_matrix<value_type, L> res{m_rows, m_cols};
+      relayout_into(res);
+      return res;
+    }
+  }
+
+  // Same as relayout(), into a matrix of the same size that already exists.
+  template <matrix_layout L> constexpr void relayout_into(contiguous_matrix<value_type, L> &res) const {
+    if ((m_cols != res.m_cols) || (m_rows != res.m_rows)) throw std::runtime_error("Mismatched matrix sizes");
+    if constexpr (std::same_as<L, Layout>) {
+      std::copy(m_buffer.begin(), m_buffer.end(), res.m_buffer.begin());
+    } else {
+      constexpr size_type block = 32;
+      auto                copy_blocks = [&] {
+        for (size_type ii = 0; ii < m_rows; ii += block) {
+          for (size_type jj = 0; jj < m_cols; jj += block) {
+            for (size_type i = ii; i < std::min(ii + block, m_rows); ++i) {
+              for (size_type j = jj; j < std::min(jj + block, m_cols); ++j) {
+                res.m_buffer[res.offset(i, j)] = m_buffer[offset(i, j)];
+              }
+            }
+          }
+        }
+      };
+      if (std::is_constant_evaluated()) copy_blocks();
+      else isa::dispatch(copy_blocks);
+    }
+  }
+
+  // Transpose by reinterpreting the buffer in the opposite storage order. O(1), steals the buffer.
+  constexpr auto transposed() && requires requires { typename Layout::transposed; } {
+    return contiguous_matrix<value_type, typename Layout::transposed>{m_cols, m_rows, std::move(m_buffer)};
+  }
+
 public:
-  contiguous_matrix &transpose() {
+  constexpr contiguous_matrix &transpose() {
+    // Padding maps onto padding under transposition, so whole tiles can be transposed without looking at the edges.
+    if constexpr (is_tiled) {
+      contiguous_matrix transposed{m_cols, m_rows};
+      isa::dispatch([&] {
+        for (size_type ti = 0; ti < tile_rows(); ++ti) {
+          for (size_type tj = 0; tj < tile_cols(); ++tj) {
+            kernels::transpose_tile(transposed.tile_data(tj, ti), tile_data(ti, tj), Layout::tile_size);
+          }
+        }
+      });
+
+      *this = std::move(transposed);
+      return *this;
+    }
+
     if (m_rows == m_cols) {
       for (size_type i = 0; i < m_rows; i++) {
         for (size_type j = i + 1; j < m_rows; j++) {
@@ -200,54 +488,170 @@ public:
     return *this;
   }
 
-  contiguous_matrix &operator*=(const contiguous_matrix &rhs) {
-    if (m_cols != rhs.m_rows) throw std::runtime_error("Mismatched matrix sizes");
-
-    contiguous_matrix res{m_rows, rhs.m_cols}, t_rhs = rhs;
-    t_rhs.transpose();
+  // res = lhs * rhs into an existing matrix, which must not alias either operand. Every entry of the product is a
+  // dot product of a row of the left operand and a column of the right one, so the kernel wants both of them
+  // contiguous; dot(row, col, n) reduces one pair of them.
+  template <typename Dot>
+  requires std::invocable<Dot &, const_pointer, const_pointer, size_type>
+  static constexpr void multiply_into(contiguous_matrix &res, const contiguous_matrix<value_type, row_major> &lhs,
+                                      const contiguous_matrix<value_type, column_major> &rhs, Dot dot) {
+    if (lhs.cols() != rhs.rows() || res.rows() != lhs.rows() || res.cols() != rhs.cols()) {
+      throw std::runtime_error("Mismatched matrix sizes");
+    }
 
-    for (size_type i = 0; i < m_rows; i++) {
-      for (size_type j = 0; j < t_rhs.m_rows; j++) {
-        const auto range_first = (*this)[i], range_second = t_rhs[j];
-        res[i][j] = ranges::accumulate(
-            ranges::views::zip_with(std::multiplies<value_type>{}, range_first, range_second), value_type{});
+    auto entry = [&lhs, &rhs, &dot](size_type i, size_type j) {
+      return dot(lhs.data() + i * lhs.cols(), rhs.data() + j * rhs.rows(), lhs.cols());
+    };
+
+    // Lines of the result along the storage order are independent, so they are split between the pool threads and each
+    // chunk runs through the clone for the active instruction set. Constant evaluation fills them in order.
+    constexpr bool  by_cols = is_column_major;
+    const size_type lines = (by_cols ? res.m_cols : res.m_rows), length = (by_cols ? res.m_rows : res.m_cols);
+    auto            fill = [&res, &entry, length](size_type first, size_type last) {
+      for (size_type line = first; line < last; line++) {
+        for (size_type k = 0; k < length; k++) {
+          size_type i = (by_cols ? k : line), j = (by_cols ? line : k);
+          res.m_buffer[res.offset(i, j)] = entry(i, j);
+        }
       }
+    };
+
+    if (std::is_constant_evaluated()) fill(0, lines);
+    else {
+      concurrency::parallel_for(0, lines, concurrency::grain_for(length * lhs.cols()),
+                                [&fill](size_type first, size_type last) { isa::dispatch([&] { fill(first, last); }); });
     }
+  }
+
+  template <summation_policy P = default_summation>
+  static constexpr void multiply_into(contiguous_matrix &res, const contiguous_matrix<value_type, row_major> &lhs,
+                                      const contiguous_matrix<value_type, column_major> &rhs, P = {}) {
+    multiply_into(res, lhs, rhs, [](const_pointer a, const_pointer b, size_type n) { return P::dot(a, b, n); });
+  }
+
+private:
+  template <summation_policy P>
+  static constexpr contiguous_matrix multiply(const contiguous_matrix<value_type, row_major>    &lhs,
+                                              const contiguous_matrix<value_type, column_major> &rhs) {
+    contiguous_matrix res{lhs.rows(), rhs.cols()};
+    multiply_into<P>(res, lhs, rhs);
+    return res;
+  }
+
+  // Tile by tile product of two matrices with the same tiled layout. Zero padding makes every tile product a full
+  // tile_size^3 block update.
+  static contiguous_matrix multiply_tiled(const contiguous_matrix &lhs, const contiguous_matrix &rhs) requires is_tiled {
+    constexpr size_type tile = Layout::tile_size;
+    contiguous_matrix   res{lhs.rows(), rhs.cols()};
+
+    const size_type tile_row_work = res.tile_cols() * lhs.tile_cols() * tile * tile * tile;
+    concurrency::parallel_for(0, res.tile_rows(), concurrency::grain_for(tile_row_work),
+                              [&res, &lhs, &rhs](size_type first, size_type last) {
+                                isa::dispatch([&] {
+                                  for (size_type ti = first; ti < last; ++ti) {
+                                    for (size_type tj = 0; tj < res.tile_cols(); ++tj) {
+                                      for (size_type tk = 0; tk < lhs.tile_cols(); ++tk) {
+                                        kernels::gemm_tile_add(res.tile_data(ti, tj), lhs.tile_data(ti, tk),
+                                                               rhs.tile_data(tk, tj), tile, tile, tile, tile);
+                                      }
+                                    }
+                                  }
+                                });
+                              });
+
+    return res;
+  }
+
+public:
+  // Dot products of the result are reduced with the summation policy P. The tiled product runs on whole-tile kernels
+  // and does not use it.
+  template <summation_policy P, matrix_layout L>
+  constexpr contiguous_matrix &multiply_assign(const contiguous_matrix<value_type, L> &rhs, P = {}) {
+    if (m_cols != rhs.m_rows) throw std::runtime_error("Mismatched matrix sizes");
+
+    contiguous_matrix res = [this, &rhs]() {
+      constexpr bool rhs_column_major = std::same_as<L, column_major>;
+      if constexpr (is_tiled && std::same_as<L, Layout>) return multiply_tiled(*this, rhs);
+      else if constexpr (is_row_major && rhs_column_major) return multiply<P>(*this, rhs);
+      else if constexpr (is_row_major) return multiply<P>(*this, rhs.template relayout<column_major>());
+      else if constexpr (rhs_column_major) return multiply<P>(relayout<row_major>(), rhs);
+      else return multiply<P>(relayout<row_major>(), rhs.template relayout<column_major>());
+    }();
 
     std::swap(*this, res);
     return *this;
   }
 
-  pointer       data() { return m_buffer.data(); }
-  const_pointer data() const { return m_buffer.data(); }
+  template <matrix_layout L> constexpr contiguous_matrix &operator*=(const contiguous_matrix<value_type, L> &rhs) {
+    return multiply_assign(rhs, default_summation{});
+  }
+
+  // Raw buffer and flat iteration follow the storage order: row by row for row_major, column by column for
+  // column_major and tile by tile, padding included, for tiled.
+  constexpr pointer       data() { return m_buffer.data(); }
+  constexpr const_pointer data() const { return m_buffer.data(); }
 
   using iterator = typename containers::vector<value_type>::iterator;
   using const_iterator = typename containers::vector<value_type>::const_iterator;
 
-  iterator       begin() { return m_buffer.begin(); }
-  iterator       end() { return m_buffer.end(); }
-  const_iterator begin() const { return m_buffer.cbegin(); }
-  const_iterator end() const { return m_buffer.cend(); }
-  const_iterator cbegin() const { return m_buffer.cbegin(); }
-  const_iterator cend() const { return m_buffer.cend(); }
+  constexpr iterator       begin() { return m_buffer.begin(); }
+  constexpr iterator       end() { return m_buffer.end(); }
+  constexpr const_iterator begin() const { return m_buffer.cbegin(); }
+  constexpr const_iterator end() const { return m_buffer.cend(); }
+  constexpr const_iterator cbegin() const { return m_buffer.cbegin(); }
+  constexpr const_iterator cend() const { return m_buffer.cend(); }
 };
 
 static_assert(ranges::random_access_range<contiguous_matrix<float>>, "Contigous matrix is not a random access range");
+static_assert(ranges::random_access_range<contiguous_matrix<float, column_major>>,
+              "Column-major contigous matrix is not a random access range");
+static_assert(ranges::random_access_range<contiguous_matrix<float, tiled<>>>,
+              "Tiled contigous matrix is not a random access range");
 
 // clang-format off
-template <typename T> contiguous_matrix<T> operator*(const contiguous_matrix<T> &lhs, T rhs) { auto res = lhs; res *= rhs; return res; }
-template <typename T> contiguous_matrix<T> operator*(T lhs, const contiguous_matrix<T> &rhs) { auto res = rhs; res *= lhs; return res; }
+template <typename T, typename L> constexpr contiguous_matrix<T, L> operator*(const contiguous_matrix<T, L> &lhs, T rhs) { auto res = lhs; res *= rhs; return res; }
+template <typename T, typename L> constexpr contiguous_matrix<T, L> operator*(T lhs, const contiguous_matrix<T, L> &rhs) { auto res = rhs; res *= lhs; return res; }
+
+template <typename T, typename L> constexpr contiguous_matrix<T, L> operator+(const contiguous_matrix<T, L> &lhs, const contiguous_matrix<T, L> &rhs) { auto res = lhs; res += rhs; return res; }
+template <typename T, typename L> constexpr contiguous_matrix<T, L> operator-(const contiguous_matrix<T, L> &lhs, const contiguous_matrix<T, L> &rhs) { auto res = lhs; res -= rhs; return res; }
 
-template <typename T> contiguous_matrix<T> operator+(const contiguous_matrix<T> &lhs, const contiguous_matrix<T> &rhs) { auto res = lhs; res += rhs; return res; }
-template <typename T> contiguous_matrix<T> operator-(const contiguous_matrix<T> &lhs, const contiguous_matrix<T> &rhs) { auto res = lhs; res -= rhs; return res; }
+template <typename T, typename L1, typename L2> constexpr contiguous_matrix<T, L1> operator*(const contiguous_matrix<T, L1> &lhs, const contiguous_matrix<T, L2> &rhs) { auto res = lhs; res *= rhs; return res; }
+template <summation_policy P, typename T, typename L1, typename L2> constexpr contiguous_matrix<T, L1> multiply(const contiguous_matrix<T, L1> &lhs, const contiguous_matrix<T, L2> &rhs, P policy) { auto res = lhs; res.multiply_assign(rhs, policy); return res; }
+template <typename T, typename L> constexpr contiguous_matrix<T, L> operator/(const contiguous_matrix<T, L> &lhs, T rhs) { auto res = lhs; res /= rhs; return res; }
 
-template <typename T> contiguous_matrix<T> operator*(const contiguous_matrix<T> &lhs, const contiguous_matrix<T> &rhs) { auto res = lhs; res *= rhs; return res; }
-template <typename T> contiguous_matrix<T> operator/(const contiguous_matrix<T> &lhs, T rhs) { auto res = lhs; res /= rhs; return res; }
+template <typename T, typename L> constexpr contiguous_matrix<T, L> hadamard(const contiguous_matrix<T, L> &lhs, const contiguous_matrix<T, L> &rhs) { auto res = lhs; res.hadamard_assign(rhs); return res; }
+template <typename T, typename L, typename F> constexpr contiguous_matrix<T, L> map(const contiguous_matrix<T, L> &mat, F f) { auto res = mat; res.apply(f); return res; }
+template <typename T, typename L, typename F> constexpr contiguous_matrix<T, L> map(const contiguous_matrix<T, L> &lhs, const contiguous_matrix<T, L> &rhs, F f) { auto res = lhs; res.apply(rhs, f); return res; }
 
-template <typename T> bool operator==(const contiguous_matrix<T> &lhs, const contiguous_matrix<T> &rhs) { return lhs.equal(rhs); }
-template <typename T> bool operator!=(const contiguous_matrix<T> &lhs, const contiguous_matrix<T> &rhs) { return !(lhs.equal(rhs)); }
-template <typename T> contiguous_matrix<T> transpose(const contiguous_matrix<T> &mat) { auto res = mat; res.transpose(); return res; }
+template <typename T, typename L1, typename L2> constexpr bool operator==(const contiguous_matrix<T, L1> &lhs, const contiguous_matrix<T, L2> &rhs) { return lhs.equal(rhs); }
+template <typename T, typename L1, typename L2> constexpr bool operator!=(const contiguous_matrix<T, L1> &lhs, const contiguous_matrix<T, L2> &rhs) { return !(lhs.equal(rhs)); }
+template <typename T, typename L> constexpr contiguous_matrix<T, L> transpose(const contiguous_matrix<T, L> &mat) { auto res = mat; res.transpose(); return res; }
 // clang-format on
 
+namespace detail {
+
+template <typename T, matrix_layout L> constexpr T elimination_determinant(const contiguous_matrix<T, L> &mat) {
+  if (!mat.square()) throw std::runtime_error("Mismatched matrix size for determinant");
+
+  const std::size_t n = mat.rows();
+  if (n >= 2 && n <= kernels::max_small_determinant) {
+    return kernels::small_determinant<T>(n, [&mat](std::size_t i, std::size_t j) { return mat[i][j]; });
+  }
+
+  auto copy = mat.template relayout<row_major>();
+  if constexpr (std::floating_point<T>) return kernels::lu_determinant(copy.data(), n);
+  else return kernels::bareiss_determinant(copy.data(), n);
+}
+
+} // namespace detail
+
+// Determinant by elimination on a row-major copy, usable in constant expressions. Floating point types go through the
+// partially pivoted LU kernel; other rings use fraction-free Bareiss elimination, whose divisions are exact. Sizes up
+// to kernels::max_small_determinant go through the unrolled kernels without making a copy. tiled.hpp adds an overload
+// that hands larger floating point tiled matrices to the task-parallel tiled LU.
+template <typename T, matrix_layout L> constexpr T determinant(const contiguous_matrix<T, L> &mat) {
+  return detail::elimination_determinant(mat);
+}
+
 } // namespace linmath
-} // namespace throttle
\ No newline at end of file
+} // namespace throttle
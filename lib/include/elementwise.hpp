@@ -0,0 +1,68 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "isa.hpp"
+#include "thread_pool.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace throttle {
+namespace linmath {
+namespace kernels {
+
+// Elementwise loops over flat buffers. Every chunk is a plain indexed loop over raw pointers, which the compiler
+// vectorizes once f is inlined; buffers longer than `elementwise_grain` are split between the pool threads, so f may
+// be called concurrently. Chunks run through the clone for the active instruction set, see isa.hpp. dst may be the
+// same buffer as a source. In constant evaluation they run as a single loop.
+
+inline constexpr std::size_t elementwise_grain = std::size_t{1} << 15;
+
+// dst[i] = f(src[i])
+template <typename T, typename F> constexpr void map(T *dst, const T *src, std::size_t n, F f) {
+  if (std::is_constant_evaluated()) {
+    for (std::size_t i = 0; i < n; ++i) {
+      dst[i] = f(src[i]);
+    }
+    return;
+  }
+
+  concurrency::parallel_for(0, n, elementwise_grain, [dst, src, &f](std::size_t first, std::size_t last) {
+    isa::dispatch([&] {
+      for (std::size_t i = first; i < last; ++i) {
+        dst[i] = f(src[i]);
+      }
+    });
+  });
+}
+
+// dst[i] = f(lhs[i], rhs[i])
+template <typename T, typename F> constexpr void zip(T *dst, const T *lhs, const T *rhs, std::size_t n, F f) {
+  if (std::is_constant_evaluated()) {
+    for (std::size_t i = 0; i < n; ++i) {
+      dst[i] = f(lhs[i], rhs[i]);
+    }
+    return;
+  }
+
+  concurrency::parallel_for(0, n, elementwise_grain, [dst, lhs, rhs, &f](std::size_t first, std::size_t last) {
+    isa::dispatch([&] {
+      for (std::size_t i = first; i < last; ++i) {
+        dst[i] = f(lhs[i], rhs[i]);
+      }
+    });
+  });
+}
+
+} // namespace kernels
+} // namespace linmath
+} // namespace throttle
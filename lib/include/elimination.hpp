@@ -0,0 +1,84 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "isa.hpp"
+#include "pivot.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+namespace throttle {
+namespace linmath {
+namespace kernels {
+
+// In place LU factorization with partial pivoting of the n x n row-major buffer a: U on and above the diagonal, the
+// multipliers of the unit lower triangular L below it. on_swap(k, row) is called whenever row k is exchanged with a
+// lower one. Stops at the first zero pivot and returns false; the matrix is singular then. Rows below the pivot are
+// updated independently on the pool, in constant evaluation one after another.
+template <std::floating_point T, typename S> constexpr bool lu_factorize(T *a, std::size_t n, S on_swap) {
+  for (std::size_t k = 0; k < n; ++k) {
+    std::size_t pivot_row = k;
+    if (std::is_constant_evaluated()) {
+      for (std::size_t i = k + 1; i < n; ++i) {
+        if (magnitude(a[pivot_row * n + k]) < magnitude(a[i * n + k])) pivot_row = i;
+      }
+    } else {
+      pivot_row += argmax_abs_strided(a + k * n + k, n - k, n);
+    }
+    if (a[pivot_row * n + k] == T{}) return false;
+
+    if (pivot_row != k) {
+      std::swap_ranges(a + k * n, a + (k + 1) * n, a + pivot_row * n);
+      on_swap(k, pivot_row);
+    }
+
+    const T *pivot = a + k * n;
+    auto     eliminate = [a, pivot, k, n](std::size_t first, std::size_t last) {
+      for (std::size_t i = first; i < last; ++i) {
+        T *row = a + i * n;
+        T  l_ik = (row[k] /= pivot[k]);
+        for (std::size_t j = k + 1; j < n; ++j) {
+          row[j] -= l_ik * pivot[j];
+        }
+      }
+    };
+
+    if (std::is_constant_evaluated()) {
+      eliminate(k + 1, n);
+    } else {
+      concurrency::parallel_for(k + 1, n, concurrency::grain_for(n - k),
+                                [&eliminate](std::size_t first, std::size_t last) {
+                                  isa::dispatch([&] { eliminate(first, last); });
+                                });
+    }
+  }
+  return true;
+}
+
+// Determinant of the n x n row-major buffer a, which is overwritten with its LU factors.
+template <std::floating_point T> constexpr T lu_determinant(T *a, std::size_t n) {
+  T sign{1};
+  if (!lu_factorize(a, n, [&sign](std::size_t, std::size_t) { sign = -sign; })) return T{};
+
+  T det = sign;
+  for (std::size_t i = 0; i < n; ++i) {
+    det *= a[i * n + i];
+  }
+  return det;
+}
+
+} // namespace kernels
+} // namespace linmath
+} // namespace throttle
@@ -17,27 +17,27 @@
 
 namespace throttle {
 
-template <typename T> T vmin(const T &a) { return a; }
+template <typename T> constexpr T vmin(const T &a) { return a; }
 
 template <typename T, typename... Ts, typename = std::enable_if_t<std::conjunction_v<std::is_same<T, Ts>...>>>
-T vmin(const T &a, const T &b, Ts... args) {
+constexpr T vmin(const T &a, const T &b, Ts... args) {
   return ((a > b) ? vmin(b, args...) : vmin(a, args...));
 }
 
-template <typename T> T vmax(const T &a) { return a; }
+template <typename T> constexpr T vmax(const T &a) { return a; }
 
 template <typename T, typename... Ts, typename = std::enable_if_t<std::conjunction_v<std::is_same<T, Ts>...>>>
-T vmax(const T &a, const T &b, Ts... args) {
+constexpr T vmax(const T &a, const T &b, Ts... args) {
   return ((a < b) ? vmax(b, args...) : vmax(a, args...));
 }
 
 // Precision to be used for floating point comparisons
 template <typename T> struct default_precision { static constexpr T m_prec = 1.0e-6f; };
 
-template <typename T> bool is_roughly_equal(T p_first, T p_second, T) { return p_first == p_second; };
+template <typename T> constexpr bool is_roughly_equal(T p_first, T p_second, T) { return p_first == p_second; };
 
 template <std::floating_point T>
-bool is_roughly_equal(T p_first, T p_second, T p_precision = default_precision<T>::m_prec) {
+constexpr bool is_roughly_equal(T p_first, T p_second, T p_precision = default_precision<T>::m_prec) {
   using std::abs;
   using std::max;
   T epsilon = p_precision;
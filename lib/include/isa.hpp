@@ -0,0 +1,100 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <cstdlib>
+#include <optional>
+#include <string_view>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define THROTTLE_ISA_DISPATCH 1
+#endif
+
+namespace throttle {
+namespace isa {
+
+// Runtime instruction set dispatch for the hot kernels. The default build assumes only the baseline of the target,
+// which is SSE2 on x86-64. Kernels are plain loops, so instead of intrinsics every kernel body is compiled a few more
+// times with wider instruction sets and the best clone the CPU supports is picked at run time.
+//
+// The environment variable THROTTLE_ISA (baseline, sse4.2, avx2 or avx512) caps the level, so that the narrower clones
+// can be tested on a machine that supports the wider ones. It can only lower the level.
+
+enum class level { baseline, sse42, avx2, avx512 };
+
+inline std::optional<level> parse(std::string_view name) {
+  if (name == "baseline") return level::baseline;
+  if (name == "sse4.2") return level::sse42;
+  if (name == "avx2") return level::avx2;
+  if (name == "avx512") return level::avx512;
+  return std::nullopt;
+}
+
+// Best level the CPU supports. __builtin_cpu_supports also checks that the OS saves the wide registers.
+inline level detect() {
+#ifdef THROTTLE_ISA_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512bw") &&
+      __builtin_cpu_supports("avx512dq")) {
+    return level::avx512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return level::avx2;
+  if (__builtin_cpu_supports("sse4.2")) return level::sse42;
+#endif
+  return level::baseline;
+}
+
+// Level the kernels run at. Decided once, on first use. Unknown values of THROTTLE_ISA are ignored.
+inline level active() {
+  static const level cached = [] {
+    level       best = detect();
+    const char *env = std::getenv("THROTTLE_ISA");
+    if (!env) return best;
+    auto requested = parse(env);
+    return (requested && *requested < best ? *requested : best);
+  }();
+  return cached;
+}
+
+namespace detail {
+
+// f is inlined into each clone together with everything it calls that can be inlined, so the whole kernel is compiled
+// for the clone's instruction set.
+#ifdef THROTTLE_ISA_DISPATCH
+template <typename F> [[gnu::flatten, gnu::target("sse4.2")]] decltype(auto) run_sse42(F &f) { return f(); }
+template <typename F> [[gnu::flatten, gnu::target("avx2,fma")]] decltype(auto) run_avx2(F &f) { return f(); }
+template <typename F>
+[[gnu::flatten, gnu::target("avx512f,avx512vl,avx512bw,avx512dq,avx2,fma")]] decltype(auto) run_avx512(F &f) {
+  return f();
+}
+#endif
+
+} // namespace detail
+
+// Call f() through the clone for `at`, which must not be above detect().
+template <typename F> decltype(auto) run(level at, F &&f) {
+#ifdef THROTTLE_ISA_DISPATCH
+  switch (at) {
+  case level::avx512: return detail::run_avx512(f);
+  case level::avx2: return detail::run_avx2(f);
+  case level::sse42: return detail::run_sse42(f);
+  case level::baseline: break;
+  }
+#endif
+  return f();
+}
+
+// Call f() through the clone for the active level. Dispatch costs a switch, so f should be a chunk of work such as a
+// tile update or a range of rows, not a single element.
+template <typename F> decltype(auto) dispatch(F &&f) { return run(active(), f); }
+
+} // namespace isa
+} // namespace throttle
@@ -0,0 +1,157 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace throttle {
+namespace linmath {
+
+// Storage order policies for contiguous_matrix. A policy maps (row, col) of a rows x cols matrix to an offset into the
+// flat buffer and tells how large the buffer has to be. `transposed`, when present, names the policy under which the
+// same buffer reads as the transposed matrix.
+
+struct column_major;
+
+struct row_major {
+  using transposed = column_major;
+
+  static constexpr std::size_t offset(std::size_t row, std::size_t col, std::size_t, std::size_t cols) {
+    return row * cols + col;
+  }
+
+  static constexpr std::size_t storage_size(std::size_t rows, std::size_t cols) { return rows * cols; }
+};
+
+struct column_major {
+  using transposed = row_major;
+
+  static constexpr std::size_t offset(std::size_t row, std::size_t col, std::size_t rows, std::size_t) {
+    return col * rows + row;
+  }
+
+  static constexpr std::size_t storage_size(std::size_t rows, std::size_t cols) { return rows * cols; }
+};
+
+// Block-major storage: the matrix is cut into Tile x Tile tiles, each tile is stored contiguously (row-major inside)
+// and tiles follow each other row by row. Edge tiles are padded to full size, so every tile is a dense Tile x Tile
+// block that tile kernels can work on without bounds checks. Padding is kept zero by contiguous_matrix.
+template <std::size_t Tile = 64> struct tiled {
+  static_assert(Tile > 0, "Tile size must be positive");
+
+  static constexpr std::size_t tile_size = Tile;
+  static constexpr std::size_t tile_elements = Tile * Tile;
+
+  static constexpr std::size_t tile_count(std::size_t extent) { return (extent + Tile - 1) / Tile; }
+
+  static constexpr std::size_t offset(std::size_t row, std::size_t col, std::size_t, std::size_t cols) {
+    return ((row / Tile) * tile_count(cols) + col / Tile) * tile_elements + (row % Tile) * Tile + col % Tile;
+  }
+
+  static constexpr std::size_t storage_size(std::size_t rows, std::size_t cols) {
+    return tile_count(rows) * tile_count(cols) * tile_elements;
+  }
+};
+
+template <typename L> struct is_tiled_layout : std::false_type {};
+template <std::size_t Tile> struct is_tiled_layout<tiled<Tile>> : std::true_type {};
+
+template <typename L>
+concept matrix_layout = requires(std::size_t idx) {
+  { L::offset(idx, idx, idx, idx) } -> std::same_as<std::size_t>;
+  { L::storage_size(idx, idx) } -> std::same_as<std::size_t>;
+};
+
+// Iterator over a row or a column of a matrix stored with an arbitrary layout. The offset is recomputed on every
+// access, so this is only meant for layouts where a line is neither contiguous nor evenly strided. T may be
+// const-qualified.
+template <typename T, matrix_layout Layout> class layout_line_iterator {
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = std::remove_cv_t<T>;
+  using reference = T &;
+  using pointer = T *;
+
+private:
+  pointer         m_base = nullptr;
+  std::size_t     m_row = 0, m_col = 0, m_rows = 0, m_cols = 0;
+  bool            m_along_row = true;
+  difference_type m_pos = 0;
+
+public:
+  layout_line_iterator() = default;
+  layout_line_iterator(pointer base, std::size_t row, std::size_t col, std::size_t rows, std::size_t cols,
+                       bool along_row, difference_type pos = 0)
+      : m_base{base}, m_row{row}, m_col{col}, m_rows{rows}, m_cols{cols}, m_along_row{along_row}, m_pos{pos} {}
+
+  reference operator*() const {
+    return m_along_row ? m_base[Layout::offset(m_row, m_col + m_pos, m_rows, m_cols)]
+                       : m_base[Layout::offset(m_row + m_pos, m_col, m_rows, m_cols)];
+  }
+
+  pointer operator->() const { return &**this; }
+
+  // clang-format off
+  layout_line_iterator &operator++() { ++m_pos; return *this; }
+  layout_line_iterator operator++(int) { layout_line_iterator res{*this}; ++m_pos; return res; }
+  layout_line_iterator &operator--() { --m_pos; return *this; }
+  layout_line_iterator operator--(int) { layout_line_iterator res{*this}; --m_pos; return res; }
+  layout_line_iterator &operator+=(difference_type n) { m_pos += n; return *this; }
+  layout_line_iterator &operator-=(difference_type n) { m_pos -= n; return *this; }
+  // clang-format on
+
+  friend layout_line_iterator operator+(layout_line_iterator iter, difference_type n) { return iter += n; }
+  friend layout_line_iterator operator+(difference_type n, layout_line_iterator iter) { return iter += n; }
+
+  layout_line_iterator operator-(difference_type n) const { return layout_line_iterator{*this} -= n; }
+  difference_type      operator-(const layout_line_iterator &other) const { return m_pos - other.m_pos; }
+  bool                 operator==(const layout_line_iterator &other) const { return m_pos == other.m_pos; }
+  auto                 operator<=>(const layout_line_iterator &other) const { return m_pos <=> other.m_pos; }
+
+  reference operator[](difference_type n) const { return *(*this + n); }
+};
+
+// Row or column proxy built on top of layout_line_iterator.
+template <typename T, matrix_layout Layout> class layout_line {
+  T          *m_base = nullptr;
+  std::size_t m_row = 0, m_col = 0, m_rows = 0, m_cols = 0;
+  bool        m_along_row = true;
+
+public:
+  using iterator = layout_line_iterator<T, Layout>;
+  using const_iterator = layout_line_iterator<const T, Layout>;
+
+  layout_line() = default;
+  layout_line(T *base, std::size_t row, std::size_t col, std::size_t rows, std::size_t cols, bool along_row)
+      : m_base{base}, m_row{row}, m_col{col}, m_rows{rows}, m_cols{cols}, m_along_row{along_row} {}
+
+  T &operator[](std::size_t index) const { return begin()[index]; }
+
+  iterator begin() const { return iterator{m_base, m_row, m_col, m_rows, m_cols, m_along_row}; }
+  iterator end() const { return iterator{m_base, m_row, m_col, m_rows, m_cols, m_along_row, difference()}; }
+
+  const_iterator cbegin() const { return const_iterator{m_base, m_row, m_col, m_rows, m_cols, m_along_row}; }
+  const_iterator cend() const {
+    return const_iterator{m_base, m_row, m_col, m_rows, m_cols, m_along_row, difference()};
+  }
+
+  std::size_t size() const { return m_along_row ? m_cols - m_col : m_rows - m_row; }
+
+private:
+  std::ptrdiff_t difference() const { return static_cast<std::ptrdiff_t>(size()); }
+};
+
+} // namespace linmath
+} // namespace throttle
@@ -0,0 +1,206 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "contiguous_matrix.hpp"
+#include "elimination.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace throttle {
+namespace linmath {
+
+// Determinant as sign and logarithm of the magnitude, which neither overflows nor underflows for large matrices.
+template <std::floating_point T> struct signed_log {
+  int sign = 0; // 0 for a singular matrix
+  T   log_abs = -std::numeric_limits<T>::infinity();
+
+  T value() const { return (sign ? sign * std::exp(log_abs) : T{}); }
+};
+
+// LU factorization with partial pivoting, P * A = L * U, of a square matrix. L (unit diagonal) and U share one
+// row-major buffer. Factorization stops at the first zero pivot; the matrix is singular then and cannot be solved.
+template <std::floating_point T> class lu_decomposition {
+  using size_type = std::size_t;
+
+  contiguous_matrix<T>   m_lu;
+  std::vector<size_type> m_perm; // Row i of P * A is row m_perm[i] of A
+  int                    m_sign = 1;
+  bool                   m_singular = false;
+  T                      m_norm = 0; // |A|_1 of the matrix before factorization
+
+  void compute_norm() {
+    const size_type n = m_lu.rows();
+    std::vector<T>  col_sums(n);
+    for (size_type i = 0; i < n; ++i) {
+      const T *row = m_lu.data() + i * n;
+      for (size_type j = 0; j < n; ++j) {
+        col_sums[j] += std::abs(row[j]);
+      }
+    }
+    m_norm = (n ? *std::max_element(col_sums.begin(), col_sums.end()) : T{});
+  }
+
+  void factorize() {
+    m_singular = !kernels::lu_factorize(m_lu.data(), m_lu.rows(), [this](size_type k, size_type pivot_row) {
+      std::swap(m_perm[k], m_perm[pivot_row]);
+      m_sign = -m_sign;
+    });
+  }
+
+public:
+  lu_decomposition(contiguous_matrix<T> mat) : m_lu{std::move(mat)}, m_perm(m_lu.rows()) {
+    if (!m_lu.square()) throw std::runtime_error("Mismatched matrix size for LU decomposition");
+    std::iota(m_perm.begin(), m_perm.end(), size_type{0});
+    compute_norm();
+    factorize();
+  }
+
+  size_type                     size() const { return m_lu.rows(); }
+  bool                          singular() const { return m_singular; }
+  const contiguous_matrix<T>   &factors() const { return m_lu; }
+  const std::vector<size_type> &permutation() const { return m_perm; }
+
+  T determinant() const {
+    if (m_singular) return T{};
+    T res = m_sign;
+    for (size_type i = 0; i < size(); ++i) {
+      res *= m_lu.data()[i * size() + i];
+    }
+    return res;
+  }
+
+  signed_log<T> log_determinant() const {
+    if (m_singular) return {};
+    signed_log<T> res{m_sign, T{}};
+    for (size_type i = 0; i < size(); ++i) {
+      T diag = m_lu.data()[i * size() + i];
+      if (diag < T{}) res.sign = -res.sign;
+      res.log_abs += std::log(std::abs(diag));
+    }
+    return res;
+  }
+
+  // Solve A * x = b in place. U may be wider than T, e.g. double right-hand sides with float factors.
+  template <std::floating_point U> void solve_in_place(std::span<U> b) const {
+    if (m_singular) throw std::runtime_error("Solving with a singular matrix");
+    if (b.size() != size()) throw std::runtime_error("Mismatched vector size for solve");
+
+    const size_type n = size();
+    const T        *a = m_lu.data();
+    std::vector<U>  y(n);
+    for (size_type i = 0; i < n; ++i) {
+      U sum = b[m_perm[i]];
+      for (size_type k = 0; k < i; ++k) {
+        sum -= U(a[i * n + k]) * y[k];
+      }
+      y[i] = sum;
+    }
+
+    for (size_type i = n; i-- > 0;) {
+      U sum = y[i];
+      for (size_type k = i + 1; k < n; ++k) {
+        sum -= U(a[i * n + k]) * b[k];
+      }
+      b[i] = sum / U(a[i * n + i]);
+    }
+  }
+
+  std::vector<T> solve(std::span<const T> b) const {
+    std::vector<T> x(b.begin(), b.end());
+    solve_in_place(std::span<T>{x});
+    return x;
+  }
+
+  // Solve A^T * x = b in place: A^T = U^T * L^T * P, so forward with U^T, backward with L^T, then permute.
+  template <std::floating_point U> void solve_transposed_in_place(std::span<U> b) const {
+    if (m_singular) throw std::runtime_error("Solving with a singular matrix");
+    if (b.size() != size()) throw std::runtime_error("Mismatched vector size for solve");
+
+    const size_type n = size();
+    const T        *a = m_lu.data();
+
+    // Column-oriented substitutions, so that every step reads a row of the factors.
+    std::vector<U> z(b.begin(), b.end());
+    for (size_type i = 0; i < n; ++i) {
+      z[i] /= U(a[i * n + i]);
+      for (size_type k = i + 1; k < n; ++k) {
+        z[k] -= U(a[i * n + k]) * z[i];
+      }
+    }
+    for (size_type i = n; i-- > 0;) {
+      for (size_type k = 0; k < i; ++k) {
+        z[k] -= U(a[i * n + k]) * z[i];
+      }
+    }
+
+    for (size_type i = 0; i < n; ++i) {
+      b[m_perm[i]] = z[i];
+    }
+  }
+
+  // Estimate of the condition number |A|_1 * |A^-1|_1 in O(n^2) from the factors, by Hager's method with Higham's
+  // refinements (LAPACK's xLACON): |A^-1|_1 is the maximum of |A^-1 * x|_1 over the corners of the unit ball of the
+  // 1-norm, which a few solves with A and A^T climb towards. The result is a lower bound, almost always within a
+  // factor of three of the true value. Infinity for a singular matrix.
+  T condition_estimate() const {
+    if (m_singular) return std::numeric_limits<T>::infinity();
+
+    const size_type n = size();
+    if (!n) return T{};
+
+    auto norm1 = [](const std::vector<T> &vec) {
+      return std::accumulate(vec.begin(), vec.end(), T{}, [](T sum, T val) { return sum + std::abs(val); });
+    };
+
+    std::vector<T> x(n, T{1} / T(n)), y(n), z(n);
+    T              estimate = 0;
+    for (size_type iteration = 0; iteration < 5; ++iteration) {
+      y = x;
+      solve_in_place(std::span<T>{y});
+      T new_estimate = norm1(y);
+      if (iteration && new_estimate <= estimate) break;
+      estimate = new_estimate;
+
+      for (size_type i = 0; i < n; ++i) {
+        z[i] = (y[i] >= T{} ? T{1} : T{-1});
+      }
+      solve_transposed_in_place(std::span<T>{z});
+
+      size_type j = kernels::argmax_abs(z.data(), n);
+      T         zx = std::inner_product(z.begin(), z.end(), x.begin(), T{});
+      if (iteration && std::abs(z[j]) <= zx) break;
+      std::fill(x.begin(), x.end(), T{});
+      x[j] = T{1};
+    }
+
+    // Higham's safeguard against matrices that fool the iteration: an alternating vector of slowly growing entries.
+    for (size_type i = 0; i < n; ++i) {
+      T sign = (i % 2 ? T{-1} : T{1});
+      x[i] = sign * (T{1} + (n > 1 ? T(i) / T(n - 1) : T{}));
+    }
+    solve_in_place(std::span<T>{x});
+    estimate = std::max(estimate, 2 * norm1(x) / T(3 * n));
+
+    return m_norm * estimate;
+  }
+};
+
+} // namespace linmath
+} // namespace throttle
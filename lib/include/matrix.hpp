@@ -10,8 +10,16 @@
 
 #pragma once
 
+#include "bareiss.hpp"
 #include "contiguous_matrix.hpp"
+#include "elementwise.hpp"
 #include "equal.hpp"
+#include "isa.hpp"
+#include "pivot.hpp"
+#include "small_determinant.hpp"
+#include "summation.hpp"
+#include "thread_pool.hpp"
+#include "tiled.hpp"
 #include "utility.hpp"
 
 #include <algorithm>
@@ -39,6 +47,9 @@ concept models_ordered_ring = requires(T a, T b) {
   requires std::totally_ordered<T>;
 };
 
+// Square matrices at least this large get their floating point determinant from the tiled task-parallel LU.
+inline constexpr std::size_t tiled_determinant_threshold = 256;
+
 template <typename T>
 requires models_ordered_ring<T>
 class matrix {
@@ -51,6 +62,7 @@ class matrix {
 
   contiguous_matrix<T>        m_contiguous_matrix;
   containers::vector<pointer> m_rows_vec;
+  bool                        m_identity_rows = true; // Row i is still row i of the buffer
 
   void update_rows_vec() {
     m_rows_vec.reserve(rows());
@@ -82,6 +94,24 @@ public:
 
   matrix(contiguous_matrix<T> &&c_matrix) : m_contiguous_matrix(std::move(c_matrix)) { update_rows_vec(); }
 
+  // Row pointers of the copy have to point into its own buffer, in the same (possibly permuted) order.
+  matrix(const matrix &other)
+      : m_contiguous_matrix{other.m_contiguous_matrix}, m_identity_rows{other.m_identity_rows} {
+    m_rows_vec.reserve(other.rows());
+    for (auto row : other.m_rows_vec) {
+      m_rows_vec.push_back(m_contiguous_matrix.data() + (row - other.m_contiguous_matrix.data()));
+    }
+  }
+
+  matrix &operator=(const matrix &other) {
+    matrix tmp{other};
+    std::swap(*this, tmp);
+    return *this;
+  }
+
+  matrix(matrix &&) = default;
+  matrix &operator=(matrix &&) = default;
+
   static matrix zero(size_type rows, size_type cols) { return matrix<T>{rows, cols}; }
   static matrix unity(size_type size) { return matrix{std::move(contiguous_matrix<T>::unity(size))}; }
 
@@ -172,21 +202,22 @@ public:
     return *this;
   }
 
-  void swap_rows(size_type idx1, size_type idx2) { std::swap(m_rows_vec[idx1], m_rows_vec[idx2]); }
+  void swap_rows(size_type idx1, size_type idx2) {
+    if (idx1 == idx2) return;
+    std::swap(m_rows_vec[idx1], m_rows_vec[idx2]);
+    m_identity_rows = false;
+  }
 
 public:
-  std::pair<size_type, value_type> max_in_col_greater_eq(size_type col, size_type minimum_row) {
+  std::pair<size_type, value_type> max_in_col_greater_eq(size_type col, size_type minimum_row) const {
     size_type max_row_idx = minimum_row;
-    auto      rows = this->rows();
-    auto      cmp = std::less<value_type>{};
-
-    for (size_type row = minimum_row; row < rows; row++) {
-      max_row_idx = (cmp(std::abs((*this)[max_row_idx][col]), std::abs((*this)[row][col])) ? row : max_row_idx);
-    }
+    isa::dispatch([&] {
+      max_row_idx += kernels::argmax_abs_gather<value_type>(m_rows_vec.data() + minimum_row, rows() - minimum_row, col);
+    });
     return std::make_pair(max_row_idx, (*this)[max_row_idx][col]);
   }
 
-  std::pair<size_type, value_type> max_in_col(size_type col) { return max_in_col_greater_eq(col, 0); }
+  std::pair<size_type, value_type> max_in_col(size_type col) const { return max_in_col_greater_eq(col, 0); }
 
   std::optional<std::pair<size_type, value_type>> first_non_zero_in_col(size_type col, size_type start_row = 0) const {
     for (size_type m = start_row; m < rows(); ++m) {
@@ -211,23 +242,39 @@ public:
         sign *= -1;
       }
 
-      for (size_type to_elim_row = 0; to_elim_row < rows(); to_elim_row++) {
-        if (i == to_elim_row) continue;
-
-        auto first_row = mat[to_elim_row];
-        auto second_row = mat[i];
-
-        auto coef = mat[to_elim_row][i] / pivot_elem;
-        ranges::transform(first_row, second_row, first_row.begin(),
-                          [coef](value_type left, value_type right) { return left - coef * right; });
-      }
+      // Rows are eliminated independently of each other.
+      concurrency::parallel_for(
+          0, rows(), concurrency::grain_for(cols()), [&mat, i, pivot_elem](size_type first, size_type last) {
+            isa::dispatch([&] {
+              for (size_type to_elim_row = first; to_elim_row < last; to_elim_row++) {
+                if (i == to_elim_row) continue;
+
+                auto first_row = mat[to_elim_row];
+                auto second_row = mat[i];
+
+                auto coef = mat[to_elim_row][i] / pivot_elem;
+                ranges::transform(first_row, second_row, first_row.begin(),
+                                  [coef](value_type left, value_type right) { return left - coef * right; });
+              }
+            });
+          });
     }
 
     return sign;
   }
 
+private:
+  bool small_determinant_size() const { return rows() >= 2 && rows() <= kernels::max_small_determinant; }
+
+  value_type small_determinant() const {
+    auto get = [row_ptrs = m_rows_vec.data()](size_type i, size_type j) { return row_ptrs[i][j]; };
+    return kernels::small_determinant<value_type>(rows(), get);
+  }
+
+public:
   value_type determinant() const {
     if (!square()) throw std::runtime_error("Mismatched matrix size for determinant");
+    if (small_determinant_size()) return small_determinant();
 
     value_type sign = 1;
     auto       size = rows();
@@ -255,8 +302,25 @@ public:
     return sign * mat[size - 1][size - 1];
   }
 
+  // Bareiss elimination with the exact divisions done by multiplication, on a copy with contiguous rows.
+  value_type determinant() const requires std::integral<value_type> {
+    if (!square()) throw std::runtime_error("Mismatched matrix size for determinant");
+    if (small_determinant_size()) return small_determinant();
+
+    contiguous_matrix<value_type> copy{rows(), cols()};
+    for (size_type i = 0; i < rows(); ++i) {
+      std::copy_n(m_rows_vec[i], cols(), copy.data() + i * cols());
+    }
+    return kernels::bareiss_determinant(copy.data(), rows());
+  }
+
   value_type determinant() const requires std::is_floating_point_v<value_type> {
     if (!square()) throw std::runtime_error("Mismatched matrix size for determinant");
+    if (small_determinant_size()) return small_determinant();
+
+    if (rows() >= tiled_determinant_threshold) {
+      return tiled_determinant(tiled_from_rows<value_type>(m_rows_vec.data(), rows(), cols()));
+    }
 
     matrix tmp{*this};
     auto   res = tmp.convert_to_row_echelon();
@@ -280,43 +344,64 @@ public:
     return *this;
   }
 
+private:
+  // this[i][j] = f(this[i][j], other[i][j]). Unless rows of either matrix have been swapped, buffers are in the same
+  // order and this is one flat pass; otherwise rows are gathered through the row pointers.
+  template <typename F> void combine_rows(const matrix &other, F f) {
+    if (m_identity_rows && other.m_identity_rows) {
+      kernels::zip(m_contiguous_matrix.data(), m_contiguous_matrix.data(), other.m_contiguous_matrix.data(),
+                   rows() * cols(), f);
+      return;
+    }
+
+    concurrency::parallel_for(0, rows(), concurrency::grain_for(cols()),
+                              [this, &other, &f](size_type first, size_type last) {
+                                for (size_type i = first; i < last; i++) {
+                                  pointer       row = m_rows_vec[i];
+                                  const_pointer other_row = other.m_rows_vec[i];
+                                  for (size_type j = 0; j < cols(); j++) {
+                                    row[j] = f(row[j], other_row[j]);
+                                  }
+                                }
+                              });
+  }
+
+public:
   matrix &operator+=(const matrix &other) {
     if (rows() != other.rows() || cols() != other.cols()) throw std::runtime_error("Mismatched matrix sizes");
-    for (size_type i = 0; i < rows(); ++i) {
-      auto row_first = (*this)[i];
-      auto row_second = other[i];
-      ranges::transform(row_first, row_second, row_first.begin(), std::plus<value_type>{});
-    }
+    combine_rows(other, std::plus<value_type>{});
     return *this;
   }
 
   matrix &operator-=(const matrix &other) {
     if (rows() != other.rows() || cols() != other.cols()) throw std::runtime_error("Mismatched matrix sizes");
-    for (size_type i = 0; i < rows(); ++i) {
-      auto row_first = (*this)[i];
-      auto row_second = other[i];
-      ranges::transform(row_first, row_second, row_first.begin(), std::minus<value_type>{});
-    }
+    combine_rows(other, std::minus<value_type>{});
     return *this;
   }
 
-  matrix &operator*=(const matrix &rhs) {
+  // Dot products are reduced with the summation policy P.
+  template <summation_policy P> matrix &multiply_assign(const matrix &rhs, P = {}) {
     if (cols() != rhs.rows()) throw std::runtime_error("Mismatched matrix sizes");
 
     matrix res{rows(), rhs.cols()}, t_rhs = rhs;
     t_rhs.transpose();
 
-    for (size_type i = 0; i < rows(); i++) {
-      for (size_type j = 0; j < t_rhs.rows(); j++) {
-        const auto range_first = (*this)[i], range_second = t_rhs[j];
-        res[i][j] = ranges::accumulate(
-            ranges::views::zip_with(std::multiplies<value_type>{}, range_first, range_second), value_type{});
-      }
-    }
+    concurrency::parallel_for(0, rows(), concurrency::grain_for(t_rhs.rows() * cols()),
+                              [this, &res, &t_rhs](size_type first, size_type last) {
+                                isa::dispatch([&] {
+                                  for (size_type i = first; i < last; i++) {
+                                    for (size_type j = 0; j < t_rhs.rows(); j++) {
+                                      res[i][j] = P::dot(m_rows_vec[i], t_rhs.m_rows_vec[j], cols());
+                                    }
+                                  }
+                                });
+                              });
 
     std::swap(*this, res);
     return *this;
   }
+
+  matrix &operator*=(const matrix &rhs) { return multiply_assign(rhs, default_summation{}); }
 };
 
 // clang-format off
@@ -327,6 +412,7 @@ template <typename T> matrix<T> operator+(const matrix<T> &lhs, const matrix<T>
 template <typename T> matrix<T> operator-(const matrix<T> &lhs, const matrix<T> &rhs) { auto res = lhs; res -= rhs; return res; }
 
 template <typename T> matrix<T> operator*(const matrix<T> &lhs, const matrix<T> &rhs) { auto res = lhs; res *= rhs; return res; }
+template <summation_policy P, typename T> matrix<T> multiply(const matrix<T> &lhs, const matrix<T> &rhs, P policy) { auto res = lhs; res.multiply_assign(rhs, policy); return res; }
 template <typename T> matrix<T> operator/(const matrix<T> &lhs, T rhs) { auto res = lhs; res /= rhs; return res; }
 
 template <typename T> bool operator==(const matrix<T> &lhs, const matrix<T> &rhs) { return lhs.equal(rhs); }
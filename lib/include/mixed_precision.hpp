@@ -0,0 +1,221 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "contiguous_matrix.hpp"
+#include "lu.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace throttle {
+namespace linmath {
+
+struct mixed_precision_options {
+  std::size_t max_iterations = 10;          // Refinement steps before giving up on a solve
+  bool        fallback_to_double = true;    // Redo a solve that does not converge with a double factorization
+  bool        correct_determinant = false;  // First order correction of log|det|, see mixed_lu
+};
+
+struct refined_solution {
+  std::vector<double> x;
+  std::size_t         iterations = 0;
+  bool                converged = false;
+};
+
+// O(n^3) work of a double matrix done in float: the factorization A ~ P^T * L * U is computed in single precision and
+// everything of O(n^2) around it in double.
+//
+// Solves use classic iterative refinement: residuals r = b - A * x in double, corrections from the float factors.
+// It converges to double accuracy as long as cond(A) is well below 1 / eps(float).
+//
+// The determinant of the float factors is off by a relative error of about n * eps(float) * cond(A). With E = A - Â
+// (Â being the product of the float factors), log|det A| = log|det Â| + tr(Â^-1 * E) + O(|Â^-1 * E|^2). The trace is
+// summed column by column: E * e_i is formed in double, while Â^-1 only needs float accuracy since E * e_i is already
+// of the order of the error. That brings the determinant to near double accuracy, but n solves cost more than a double
+// factorization, so it is opt-in. Stochastic trace estimates are no help here: their variance is of the same order as
+// the trace itself.
+//
+// Only a reference to the matrix is kept, for the residuals and the double fallback, so it has to outlive the
+// factorization.
+class mixed_lu {
+  using size_type = std::size_t;
+
+  const contiguous_matrix<double> &m_mat;
+  lu_decomposition<float>          m_lu;
+
+  static contiguous_matrix<float> to_float(const contiguous_matrix<double> &mat) {
+    contiguous_matrix<float> res{mat.rows(), mat.cols()};
+    std::transform(mat.data(), mat.data() + mat.rows() * mat.cols(), res.data(),
+                   [](double val) { return static_cast<float>(val); });
+    return res;
+  }
+
+  size_type size() const { return m_mat.rows(); }
+
+  // res = A * x - Â * x, where Â * x = P^T * L * (U * x) with the float factors taken exactly.
+  std::vector<double> factorization_error(std::span<const double> x) const {
+    const size_type n = size();
+    const float    *lu = m_lu.factors().data();
+    const double   *a = m_mat.data();
+
+    std::vector<double> ux(n), res(n);
+    for (size_type i = 0; i < n; ++i) {
+      for (size_type k = i; k < n; ++k) {
+        ux[i] += double(lu[i * n + k]) * x[k];
+      }
+    }
+
+    const auto &perm = m_lu.permutation();
+    for (size_type i = 0; i < n; ++i) {
+      double lux = ux[i];
+      for (size_type k = 0; k < i; ++k) {
+        lux += double(lu[i * n + k]) * ux[k];
+      }
+
+      double ax = 0;
+      for (size_type k = 0; k < n; ++k) {
+        ax += a[perm[i] * n + k] * x[k];
+      }
+      res[perm[i]] = ax - lux;
+    }
+
+    return res;
+  }
+
+  std::vector<double> residual(std::span<const double> b, std::span<const double> x) const {
+    const size_type     n = size();
+    std::vector<double> res(b.begin(), b.end());
+    for (size_type i = 0; i < n; ++i) {
+      for (size_type k = 0; k < n; ++k) {
+        res[i] -= m_mat.data()[i * n + k] * x[k];
+      }
+    }
+    return res;
+  }
+
+  static double max_norm(std::span<const double> vec) {
+    double res = 0;
+    for (auto val : vec) {
+      res = std::max(res, std::abs(val));
+    }
+    return res;
+  }
+
+public:
+  explicit mixed_lu(const contiguous_matrix<double> &mat) : m_mat{mat}, m_lu{to_float(mat)} {}
+  mixed_lu(contiguous_matrix<double> &&) = delete;
+
+  bool singular() const { return m_lu.singular(); }
+
+  refined_solution solve(std::span<const double> b, const mixed_precision_options &options = {}) const {
+    if (b.size() != size()) throw std::runtime_error("Mismatched vector size for solve");
+
+    refined_solution res;
+    if (!singular()) {
+      res.x.assign(b.begin(), b.end());
+      m_lu.solve_in_place(std::span<double>{res.x});
+
+      // Stopping criterion of LAPACK's dsgesv: |r| <= |x| * |A| * eps * sqrt(n), all in the max norm.
+      double a_norm = 0;
+      for (size_type i = 0; i < size(); ++i) {
+        const double *row = m_mat.data() + i * size();
+        a_norm = std::max(a_norm, std::accumulate(row, row + size(), 0.0,
+                                                  [](double sum, double val) { return sum + std::abs(val); }));
+      }
+      const double tolerance = a_norm * std::numeric_limits<double>::epsilon() * std::sqrt(double(size()));
+
+      double prev_norm = std::numeric_limits<double>::infinity();
+      for (;;) {
+        auto   correction = residual(b, res.x);
+        double norm = max_norm(correction);
+        if (norm <= tolerance * max_norm(res.x)) {
+          res.converged = true;
+          break;
+        }
+        // Residuals that stop shrinking mean the matrix is too ill-conditioned for float factors.
+        if (res.iterations == options.max_iterations || norm > prev_norm / 2) break;
+        prev_norm = norm;
+
+        m_lu.solve_in_place(std::span<double>{correction});
+        ++res.iterations;
+        for (size_type i = 0; i < size(); ++i) {
+          res.x[i] += correction[i];
+        }
+      }
+    }
+
+    if (!res.converged && options.fallback_to_double) {
+      lu_decomposition<double> lu{m_mat};
+      res.x.assign(b.begin(), b.end());
+      lu.solve_in_place(std::span<double>{res.x});
+      res.converged = true;
+    }
+
+    return res;
+  }
+
+  signed_log<double> log_determinant(const mixed_precision_options &options = {}) const {
+    if (singular()) return {};
+
+    // Summing logs of the float pivots in float would lose more than the correction brings back.
+    const size_type    n = size();
+    signed_log<double> res{m_lu.log_determinant().sign, 0.0};
+    for (size_type i = 0; i < n; ++i) {
+      res.log_abs += std::log(std::abs(double(m_lu.factors().data()[i * n + i])));
+    }
+
+    if (!options.correct_determinant) return res;
+
+    // Columns are independent; diagonal entries are summed in order afterwards to keep the result deterministic.
+    std::vector<double> diagonal(n);
+    concurrency::parallel_for(0, n, concurrency::grain_for(n * n),
+                              [this, n, &diagonal](size_type first, size_type last) {
+                                std::vector<double> unit(n);
+                                for (size_type i = first; i < last; ++i) {
+                                  unit[i] = 1.0;
+                                  auto col = factorization_error(unit);
+                                  m_lu.solve_in_place(std::span<double>{col});
+                                  diagonal[i] = col[i];
+                                  unit[i] = 0.0;
+                                }
+                              });
+
+    res.log_abs += std::accumulate(diagonal.begin(), diagonal.end(), 0.0);
+    return res;
+  }
+};
+
+inline refined_solution solve_mixed(const contiguous_matrix<double> &mat, std::span<const double> b,
+                                    const mixed_precision_options &options = {}) {
+  if (!mat.square()) throw std::runtime_error("Mismatched matrix size for solve");
+  return mixed_lu{mat}.solve(b, options);
+}
+
+inline signed_log<double> log_determinant_mixed(const contiguous_matrix<double> &mat,
+                                                const mixed_precision_options   &options = {}) {
+  if (!mat.square()) throw std::runtime_error("Mismatched matrix size for determinant");
+  return mixed_lu{mat}.log_determinant(options);
+}
+
+inline double determinant_mixed(const contiguous_matrix<double> &mat, const mixed_precision_options &options = {}) {
+  return log_determinant_mixed(mat, options).value();
+}
+
+} // namespace linmath
+} // namespace throttle
@@ -0,0 +1,238 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "contiguous_matrix.hpp"
+#include "matrix.hpp"
+#include "pivot.hpp"
+#include "summation.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace throttle {
+namespace linmath {
+
+namespace detail {
+
+// std::max that lets a NaN in either argument through, so that max reductions do not drop NaN entries.
+template <typename T> constexpr T nan_max(T a, T b) {
+  if constexpr (std::floating_point<T>) {
+    if (a != a) return a;
+    if (b != b) return b;
+  }
+  return std::max(a, b);
+}
+
+// Single pass reductions over the lines of a matrix: rows of a row-major matrix or of a matrix<T>, columns of a
+// column-major one. Every line is contiguous and is reduced with independent lanes so that the loop vectorizes.
+//
+// Lines are grouped into blocks of about `block_elements` entries that the pool reduces in parallel, and the partial
+// results are combined in block order. Blocks do not depend on the number of threads, so neither does the rounding.
+template <typename T, typename Line> class line_reducer {
+  using size_type = std::size_t;
+
+  static constexpr size_type block_elements = size_type{1} << 15;
+  static constexpr size_type cross_blocks = 64; // Blocks for sums across lines, each needs a vector of partial sums
+
+  size_type m_lines, m_length;
+  Line      m_line;
+
+  template <typename R, typename F, typename C>
+  R blocked(size_type lines_per_block, R init, F reduce, C combine) const {
+    const size_type blocks = (m_lines + lines_per_block - 1) / lines_per_block;
+    std::vector<R>  partial(blocks, init);
+    concurrency::parallel_for(0, blocks, 1, [&](size_type first, size_type last) {
+      for (size_type b = first; b < last; ++b) {
+        partial[b] = reduce(b * lines_per_block, std::min(m_lines, (b + 1) * lines_per_block));
+      }
+    });
+    return std::accumulate(partial.begin(), partial.end(), init, combine);
+  }
+
+  template <typename R, typename Term, typename C> R over_lines(R init, Term term, C combine) const {
+    const size_type lines_per_block = std::max<size_type>(1, block_elements / std::max<size_type>(1, m_length));
+    return blocked(lines_per_block, init, [&](size_type first, size_type last) {
+      R acc = init;
+      for (size_type i = first; i < last; ++i) {
+        acc = combine(acc, term(m_line(i)));
+      }
+      return acc;
+    }, combine);
+  }
+
+  template <typename Op> T lanes_max(const T *line, Op op) const {
+    constexpr size_type lanes = lane_summation::lanes;
+    T                   acc[lanes] = {};
+    size_type           j = 0;
+    for (; j + lanes <= m_length; j += lanes) {
+      for (size_type l = 0; l < lanes; ++l) {
+        acc[l] = nan_max(acc[l], op(line[j + l]));
+      }
+    }
+    for (size_type l = 0; l < m_length - j; ++l) {
+      acc[l] = nan_max(acc[l], op(line[j + l]));
+    }
+    return std::accumulate(acc, acc + lanes, T{}, nan_max<T>);
+  }
+
+public:
+  line_reducer(size_type lines, size_type length, Line line) : m_lines{lines}, m_length{length}, m_line{line} {}
+
+  T sum() const {
+    return over_lines(T{}, [this](const T *line) {
+      return lane_summation::sum<T>(m_length, [line](size_type j) { return line[j]; });
+    }, std::plus<T>{});
+  }
+
+  T sum_of_squares() const {
+    return over_lines(T{}, [this](const T *line) { return lane_summation::dot(line, line, m_length); }, std::plus<T>{});
+  }
+
+  T sum_of_squares_scaled(T scale) const {
+    return over_lines(T{}, [this, scale](const T *line) {
+      return lane_summation::sum<T>(m_length, [line, scale](size_type j) {
+        T val = line[j] / scale;
+        return val * val;
+      });
+    }, std::plus<T>{});
+  }
+
+  T max_abs() const {
+    return over_lines(T{}, [this](const T *line) { return lanes_max(line, kernels::magnitude<T>); }, nan_max<T>);
+  }
+
+  // Largest sum of magnitudes along a line.
+  T max_line_sum() const {
+    return over_lines(T{}, [this](const T *line) {
+      return lane_summation::sum<T>(m_length, [line](size_type j) { return kernels::magnitude(line[j]); });
+    }, nan_max<T>);
+  }
+
+  // Largest sum of magnitudes across lines, i.e. over one position of every line.
+  T max_cross_sum() const {
+    const size_type lines_per_block = std::max<size_type>(1, (m_lines + cross_blocks - 1) / cross_blocks);
+    auto            sums = blocked(lines_per_block, std::vector<T>{}, [this](size_type first, size_type last) {
+      std::vector<T> acc(m_length);
+      for (size_type i = first; i < last; ++i) {
+        const T *line = m_line(i);
+        for (size_type j = 0; j < m_length; ++j) {
+          acc[j] += kernels::magnitude(line[j]);
+        }
+      }
+      return acc;
+    }, [](std::vector<T> acc, const std::vector<T> &part) {
+      if (acc.empty()) return part;
+      for (std::size_t j = 0; j < part.size(); ++j) {
+        acc[j] += part[j];
+      }
+      return acc;
+    });
+    return std::accumulate(sums.begin(), sums.end(), T{}, nan_max<T>);
+  }
+};
+
+template <typename T, matrix_layout L> auto make_line_reducer(const contiguous_matrix<T, L> &mat) {
+  constexpr bool by_rows = !std::same_as<L, column_major>;
+  const T       *data = mat.data();
+  std::size_t    lines = (by_rows ? mat.rows() : mat.cols()), length = (by_rows ? mat.cols() : mat.rows());
+
+  // Padding of tiled matrices is zero, so the buffer can be reduced as one block of tiles. Only sums along and across
+  // lines need actual rows and columns.
+  if constexpr (is_tiled_layout<L>::value) {
+    lines = mat.tile_rows() * mat.tile_cols() * L::tile_size;
+    length = L::tile_size;
+  }
+
+  auto line = [data, length](std::size_t i) { return data + i * length; };
+  return line_reducer<T, decltype(line)>{lines, length, line};
+}
+
+template <typename T> auto make_line_reducer(const matrix<T> &mat) {
+  auto line = [&mat](std::size_t i) { return &mat[i][0]; };
+  return line_reducer<T, decltype(line)>{(mat.cols() ? mat.rows() : 0), mat.cols(), line};
+}
+
+// Frobenius norm from the plain sum of squares, rescaled by the largest magnitude in the rare case that the sum
+// overflows or underflows. A zero sum may also be an underflow, so it takes the slow path as well.
+template <typename Reducer> auto frobenius(const Reducer &reducer) {
+  auto sum = reducer.sum_of_squares();
+  using T = decltype(sum);
+  if (std::isfinite(sum) && sum >= std::numeric_limits<T>::min()) return std::sqrt(sum);
+
+  T scale = reducer.max_abs();
+  if (scale == T{} || !std::isfinite(scale)) return scale;
+  return scale * std::sqrt(reducer.sum_of_squares_scaled(scale));
+}
+
+} // namespace detail
+
+// Sum of all entries.
+template <typename T, matrix_layout L> T sum(const contiguous_matrix<T, L> &mat) {
+  return detail::make_line_reducer(mat).sum();
+}
+
+template <typename T> T sum(const matrix<T> &mat) { return detail::make_line_reducer(mat).sum(); }
+
+template <typename T, matrix_layout L> T trace(const contiguous_matrix<T, L> &mat) {
+  if (!mat.square()) throw std::runtime_error("Mismatched matrix size for trace");
+  return default_summation::sum<T>(mat.rows(), [&mat](std::size_t i) { return mat[i][i]; });
+}
+
+template <typename T> T trace(const matrix<T> &mat) {
+  if (!mat.square()) throw std::runtime_error("Mismatched matrix size for trace");
+  return default_summation::sum<T>(mat.rows(), [&mat](std::size_t i) { return mat[i][i]; });
+}
+
+// Largest magnitude of an entry.
+template <typename T, matrix_layout L> T max_abs(const contiguous_matrix<T, L> &mat) {
+  return detail::make_line_reducer(mat).max_abs();
+}
+
+template <typename T> T max_abs(const matrix<T> &mat) { return detail::make_line_reducer(mat).max_abs(); }
+
+// Largest column sum of magnitudes.
+template <typename T, matrix_layout L> T norm_1(const contiguous_matrix<T, L> &mat) {
+  if constexpr (is_tiled_layout<L>::value) return norm_1(mat.template relayout<row_major>());
+  else if constexpr (std::same_as<L, column_major>) return detail::make_line_reducer(mat).max_line_sum();
+  else return detail::make_line_reducer(mat).max_cross_sum();
+}
+
+template <typename T> T norm_1(const matrix<T> &mat) { return detail::make_line_reducer(mat).max_cross_sum(); }
+
+// Largest row sum of magnitudes.
+template <typename T, matrix_layout L> T norm_inf(const contiguous_matrix<T, L> &mat) {
+  if constexpr (is_tiled_layout<L>::value) return norm_inf(mat.template relayout<row_major>());
+  else if constexpr (std::same_as<L, column_major>) return detail::make_line_reducer(mat).max_cross_sum();
+  else return detail::make_line_reducer(mat).max_line_sum();
+}
+
+template <typename T> T norm_inf(const matrix<T> &mat) { return detail::make_line_reducer(mat).max_line_sum(); }
+
+template <std::floating_point T, matrix_layout L> T norm_frobenius(const contiguous_matrix<T, L> &mat) {
+  return detail::frobenius(detail::make_line_reducer(mat));
+}
+
+template <std::floating_point T> T norm_frobenius(const matrix<T> &mat) {
+  return detail::frobenius(detail::make_line_reducer(mat));
+}
+
+} // namespace linmath
+} // namespace throttle
@@ -0,0 +1,306 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "pivot.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace throttle {
+namespace linmath {
+
+struct out_of_core_options {
+  std::size_t           memory_budget = std::size_t{1} << 30; // Bytes for panel buffers, three panels at a time
+  bool                  in_place = false;                     // Overwrite the input with the factors instead of a copy
+  std::filesystem::path scratch_dir = std::filesystem::temp_directory_path();
+};
+
+namespace detail {
+
+// Read-write shared mapping of a whole file.
+class mapped_file {
+  int         m_fd = -1;
+  void       *m_data = MAP_FAILED;
+  std::size_t m_size = 0;
+
+  static std::runtime_error error(const std::string &what, const std::filesystem::path &path) {
+    return std::runtime_error{what + " " + path.string() + ": " + std::strerror(errno)};
+  }
+
+public:
+  mapped_file(const std::filesystem::path &path) {
+    m_fd = ::open(path.c_str(), O_RDWR);
+    if (m_fd < 0) throw error("Can't open", path);
+
+    struct stat st;
+    if (::fstat(m_fd, &st) < 0) {
+      ::close(m_fd);
+      throw error("Can't stat", path);
+    }
+
+    m_size = static_cast<std::size_t>(st.st_size);
+    if (!m_size) return;
+
+    m_data = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (m_data == MAP_FAILED) {
+      ::close(m_fd);
+      throw error("Can't map", path);
+    }
+  }
+
+  mapped_file(const mapped_file &) = delete;
+  mapped_file &operator=(const mapped_file &) = delete;
+
+  ~mapped_file() {
+    if (m_data != MAP_FAILED) ::munmap(m_data, m_size);
+    ::close(m_fd);
+  }
+
+  std::size_t size() const { return m_size; }
+  char       *data() { return static_cast<char *>(m_data); }
+
+  void will_need(std::size_t offset, std::size_t len) {
+    std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)), first = offset / page * page;
+    ::madvise(data() + first, std::min(m_size, offset + len) - first, MADV_WILLNEED);
+  }
+};
+
+// Left-looking LU with partial pivoting over column panels of a column-major n x n file. Panel p is brought into
+// memory, updated with every factored panel q < p in order (swaps of q, U_qp = L_qq^-1 A_qp, A_ip -= L_iq U_qp),
+// factorized and written back. Panels are streamed through two buffers, the next one being read on the pool while the
+// current one is used, so at most three panels are resident at any time.
+template <std::floating_point T> class out_of_core_lu {
+  using size_type = std::size_t;
+
+  struct panel {
+    std::vector<T> m_data;
+    size_type      m_index = 0, m_first_row = 0;
+  };
+
+  mapped_file                                 &m_file;
+  concurrency::thread_pool                    &m_pool;
+  size_type                                    m_size, m_width, m_panels;
+  std::vector<size_type>                       m_pivots;
+  panel                                        m_current, m_stream, m_prefetch;
+  std::atomic<bool>                            m_prefetch_done = true;
+  std::vector<std::pair<size_type, size_type>> m_schedule; // (panel, first row) of the reads of one step
+  size_type                                    m_next_load = 0;
+
+  size_type first_col(size_type p) const { return p * m_width; }
+  size_type panel_cols(size_type p) const { return std::min(m_width, m_size - first_col(p)); }
+  T        *file_col(size_type col) { return reinterpret_cast<T *>(m_file.data()) + col * m_size; }
+
+  void read(panel &dst, size_type p, size_type first_row) {
+    size_type rows = m_size - first_row, cols = panel_cols(p);
+    dst.m_index = p;
+    dst.m_first_row = first_row;
+    dst.m_data.resize(rows * cols);
+    for (size_type j = 0; j < cols; ++j) {
+      std::memcpy(dst.m_data.data() + j * rows, file_col(first_col(p) + j) + first_row, rows * sizeof(T));
+    }
+  }
+
+  void write_back(const panel &src) {
+    size_type rows = m_size - src.m_first_row;
+    for (size_type j = 0; j < panel_cols(src.m_index); ++j) {
+      std::memcpy(file_col(first_col(src.m_index) + j) + src.m_first_row, src.m_data.data() + j * rows,
+                  rows * sizeof(T));
+    }
+  }
+
+  void request(size_type p, size_type first_row) {
+    m_file.will_need(first_col(p) * m_size * sizeof(T), panel_cols(p) * m_size * sizeof(T));
+    m_prefetch_done.store(false, std::memory_order_relaxed);
+    m_pool.submit([this, p, first_row] {
+      read(m_prefetch, p, first_row);
+      m_prefetch_done.store(true, std::memory_order_release);
+      m_pool.notify();
+    });
+  }
+
+  // Wait for the pending read, hand its buffer over and start the next read of the schedule.
+  void take(panel &dst) {
+    m_pool.wait_until([this] { return m_prefetch_done.load(std::memory_order_acquire); });
+    std::swap(dst, m_prefetch);
+    if (m_next_load < m_schedule.size()) {
+      auto [p, first_row] = m_schedule[m_next_load++];
+      request(p, first_row);
+    }
+  }
+
+  // Reads that follow the current panel of step p: the factored part of every panel before it, then the next panel.
+  // The next panel does not overlap with the current one, so it is read while p is being factorized. Reads of
+  // factored panels for step p + 1 only start once step p has written its panel back.
+  void plan_step(size_type p) {
+    m_schedule.clear();
+    for (size_type q = 0; q < p; ++q) {
+      m_schedule.emplace_back(q, first_col(q));
+    }
+    if (p + 1 < m_panels) m_schedule.emplace_back(p + 1, 0);
+    m_next_load = 0;
+  }
+
+  // Apply the factored panel `l` to the current panel. Columns of the current panel are independent.
+  void update(const panel &l) {
+    const size_type q0 = l.m_first_row, wq = panel_cols(l.m_index), l_rows = m_size - q0;
+
+    concurrency::parallel_for(
+        0, panel_cols(m_current.m_index), concurrency::grain_for(l_rows * wq),
+        [this, &l, q0, wq, l_rows](size_type first, size_type last) {
+          for (size_type j = first; j < last; ++j) {
+            T *col = m_current.m_data.data() + j * m_size;
+
+            for (size_type c = q0; c < q0 + wq; ++c) {
+              if (m_pivots[c] != c) std::swap(col[c], col[m_pivots[c]]);
+            }
+
+            for (size_type c = 0; c < wq; ++c) {
+              const T *l_col = l.m_data.data() + c * l_rows;
+              T        u_cj = col[q0 + c];
+              for (size_type r = c + 1; r < l_rows; ++r) {
+                col[q0 + r] -= l_col[r] * u_cj;
+              }
+            }
+          }
+        });
+  }
+
+  // Unblocked LU of the current panel below its diagonal block. Returns the sign of the swaps or 0 for a zero pivot.
+  int factorize_current() {
+    const size_type p0 = first_col(m_current.m_index), w = panel_cols(m_current.m_index);
+    int             sign = 1;
+
+    for (size_type c = 0; c < w; ++c) {
+      size_type diag = p0 + c;
+      T        *col = m_current.m_data.data() + c * m_size;
+      size_type pivot_row = diag + kernels::argmax_abs(col + diag, m_size - diag);
+
+      m_pivots[diag] = pivot_row;
+      if (col[pivot_row] == T{}) return 0;
+      if (pivot_row != diag) {
+        for (size_type j = 0; j < w; ++j) {
+          T *other = m_current.m_data.data() + j * m_size;
+          std::swap(other[diag], other[pivot_row]);
+        }
+        sign = -sign;
+      }
+
+      T pivot = col[diag];
+      for (size_type i = diag + 1; i < m_size; ++i) {
+        col[i] /= pivot;
+      }
+      for (size_type j = c + 1; j < w; ++j) {
+        T *other = m_current.m_data.data() + j * m_size;
+        T  u_cj = other[diag];
+        for (size_type i = diag + 1; i < m_size; ++i) {
+          other[i] -= col[i] * u_cj;
+        }
+      }
+    }
+
+    return sign;
+  }
+
+public:
+  out_of_core_lu(mapped_file &file, size_type size, size_type width, concurrency::thread_pool &pool)
+      : m_file{file}, m_pool{pool}, m_size{size}, m_width{width}, m_panels{(size + width - 1) / width},
+        m_pivots(size) {}
+
+  ~out_of_core_lu() {
+    m_pool.wait_until([this] { return m_prefetch_done.load(std::memory_order_acquire); });
+  }
+
+  T determinant() {
+    // The diagonal is accumulated as mantissa and exponent so that intermediate products do not overflow.
+    T   mantissa = 1;
+    int exponent = 0, sign = 1;
+
+    request(0, 0);
+    for (size_type p = 0; p < m_panels; ++p) {
+      plan_step(p);
+      take(m_current);
+      for (size_type q = 0; q < p; ++q) {
+        take(m_stream);
+        update(m_stream);
+      }
+
+      int step_sign = factorize_current();
+      if (!step_sign) return T{};
+      sign *= step_sign;
+      write_back(m_current);
+
+      for (size_type c = 0; c < panel_cols(p); ++c) {
+        int exp;
+        mantissa = std::frexp(mantissa * m_current.m_data[c * m_size + first_col(p) + c], &exp);
+        exponent += exp;
+      }
+    }
+
+    return sign * std::ldexp(mantissa, exponent);
+  }
+};
+
+} // namespace detail
+
+// Determinant of an n x n matrix stored as n * n raw elements of type T, row by row, in a binary file that may be
+// larger than memory. The file is factorized through a memory mapping; the stored row-major matrix read column by
+// column is its transpose, which has the same determinant, so panels are contiguous strips of the file. Unless
+// `in_place` is set the work happens on a scratch copy in `scratch_dir` that is removed afterwards.
+template <std::floating_point T>
+T determinant_out_of_core(const std::filesystem::path &path, std::size_t n, const out_of_core_options &options = {},
+                          concurrency::thread_pool &pool = concurrency::thread_pool::instance()) {
+  if (!n) throw std::runtime_error("Mismatched matrix size for determinant");
+  if (std::filesystem::file_size(path) != n * n * sizeof(T)) {
+    throw std::runtime_error("File size does not match matrix size");
+  }
+
+  struct scratch_guard {
+    std::filesystem::path m_path;
+    ~scratch_guard() {
+      std::error_code ec;
+      if (!m_path.empty()) std::filesystem::remove(m_path, ec);
+    }
+  } scratch;
+
+  std::filesystem::path work = path;
+  if (!options.in_place) {
+    scratch.m_path =
+        options.scratch_dir / ("throttle-lu-" + std::to_string(::getpid()) + "-" + path.filename().string());
+    std::filesystem::copy_file(path, scratch.m_path, std::filesystem::copy_options::overwrite_existing);
+    work = scratch.m_path;
+  }
+
+  std::size_t width = std::clamp<std::size_t>(options.memory_budget / (3 * n * sizeof(T)), 1, n);
+
+  detail::mapped_file       file{work};
+  detail::out_of_core_lu<T> lu{file, n, width, pool};
+  return lu.determinant();
+}
+
+} // namespace linmath
+} // namespace throttle
@@ -0,0 +1,144 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace throttle {
+namespace linmath {
+namespace kernels {
+
+// Usable in constant expressions, where std::abs is not.
+template <typename T> constexpr T magnitude(const T &val) {
+  if constexpr (std::is_unsigned_v<T>) return val;
+  else if constexpr (std::floating_point<T>) {
+    if (!std::is_constant_evaluated()) return std::abs(val);
+  }
+  return (val < T{} ? T{} - val : val);
+}
+
+// Number of independent accumulators in pivot search. Each lane keeps its own running maximum so that the compiler is
+// free to turn the inner loop into a packed compare + blend instead of a serial dependency chain on a single maximum.
+inline constexpr std::size_t pivot_search_lanes = 8;
+
+// Columns at least this tall are split into blocks of pivot_search_block elements that are scanned on the pool.
+inline constexpr std::size_t parallel_pivot_search_threshold = std::size_t{1} << 17;
+inline constexpr std::size_t pivot_search_block = std::size_t{1} << 14;
+
+namespace detail {
+
+// Reduce per-lane results. Ties are resolved in favor of the smallest index so that the answer is the same as with the
+// sequential left-to-right scan.
+template <typename T>
+std::size_t reduce_lanes(const T (&best)[pivot_search_lanes], const std::size_t (&best_idx)[pivot_search_lanes]) {
+  std::size_t lane = 0;
+  for (std::size_t l = 1; l < pivot_search_lanes; ++l) {
+    if (best[lane] < best[l] || (!(best[l] < best[lane]) && best_idx[l] < best_idx[lane])) lane = l;
+  }
+  return best_idx[lane];
+}
+
+// Lane-parallel scan shared by the public kernels below. `get(i)` yields the i-th element of the searched column.
+template <typename T, typename F> std::size_t argmax_abs_impl(std::size_t count, F get) {
+  if (count < pivot_search_lanes) {
+    std::size_t max_idx = 0;
+    T           max_val = magnitude<T>(get(0));
+    for (std::size_t i = 1; i < count; ++i) {
+      T val = magnitude<T>(get(i));
+      if (max_val < val) {
+        max_val = val;
+        max_idx = i;
+      }
+    }
+    return max_idx;
+  }
+
+  T           best[pivot_search_lanes];
+  std::size_t best_idx[pivot_search_lanes];
+  for (std::size_t l = 0; l < pivot_search_lanes; ++l) {
+    best[l] = magnitude<T>(get(l));
+    best_idx[l] = l;
+  }
+
+  std::size_t i = pivot_search_lanes;
+  for (; i + pivot_search_lanes <= count; i += pivot_search_lanes) {
+    for (std::size_t l = 0; l < pivot_search_lanes; ++l) {
+      T    val = magnitude<T>(get(i + l));
+      bool greater = best[l] < val;
+      best[l] = (greater ? val : best[l]);
+      best_idx[l] = (greater ? i + l : best_idx[l]);
+    }
+  }
+
+  for (std::size_t l = 0; i < count; ++i, ++l) {
+    T val = magnitude<T>(get(i));
+    if (best[l] < val) {
+      best[l] = val;
+      best_idx[l] = i;
+    }
+  }
+
+  return reduce_lanes(best, best_idx);
+}
+
+// Scan a tall column block by block on the pool. Blocks are reduced in order, so ties still go to the smallest index.
+template <typename T, typename F> std::size_t argmax_abs_split(std::size_t count, F get) {
+  if (count < parallel_pivot_search_threshold) return argmax_abs_impl<T>(count, get);
+
+  const std::size_t        blocks = (count + pivot_search_block - 1) / pivot_search_block;
+  std::vector<std::size_t> block_max(blocks);
+  concurrency::parallel_for(0, blocks, 1, [count, &get, &block_max](std::size_t first, std::size_t last) {
+    for (std::size_t b = first; b < last; ++b) {
+      std::size_t offset = b * pivot_search_block, length = std::min(pivot_search_block, count - offset);
+      block_max[b] = offset + argmax_abs_impl<T>(length, [offset, &get](std::size_t i) { return get(offset + i); });
+    }
+  });
+
+  std::size_t max_idx = block_max[0];
+  T           max_val = magnitude<T>(get(max_idx));
+  for (std::size_t b = 1; b < blocks; ++b) {
+    T val = magnitude<T>(get(block_max[b]));
+    if (max_val < val) {
+      max_val = val;
+      max_idx = block_max[b];
+    }
+  }
+  return max_idx;
+}
+
+} // namespace detail
+
+// Index of the first element with the largest magnitude in [first, first + count). The range must not be empty.
+template <typename T> std::size_t argmax_abs(const T *first, std::size_t count) {
+  return detail::argmax_abs_split<T>(count, [first](std::size_t i) { return first[i]; });
+}
+
+// Same as above for elements that are `stride` apart, e.g. a column of a row-major buffer.
+template <typename T> std::size_t argmax_abs_strided(const T *first, std::size_t count, std::size_t stride) {
+  return detail::argmax_abs_split<T>(count, [first, stride](std::size_t i) { return first[i * stride]; });
+}
+
+// Same as above for a column that is scattered across rows: looks at rows[i][col] for i in [0, count). This is what
+// matrix with permuted row pointers has to use.
+template <typename T> std::size_t argmax_abs_gather(const T *const *rows, std::size_t count, std::size_t col) {
+  return detail::argmax_abs_split<T>(count, [rows, col](std::size_t i) { return rows[i][col]; });
+}
+
+} // namespace kernels
+} // namespace linmath
+} // namespace throttle
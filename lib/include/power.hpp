@@ -0,0 +1,131 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "contiguous_matrix.hpp"
+#include "matrix.hpp"
+#include "summation.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace throttle {
+namespace linmath {
+
+namespace detail {
+
+// Binary exponentiation, least significant bit first. mul(res, lhs, rhs) stores lhs * rhs into res. All buffers are
+// allocated up front: the result, the running square, its column-major copy for the kernel and one scratch matrix
+// that every product is written to and then swapped with its destination, so no multiplication allocates.
+template <typename T, typename Mul> contiguous_matrix<T> pow_impl(contiguous_matrix<T> base, std::uint64_t k, Mul mul) {
+  using size_type = typename contiguous_matrix<T>::size_type;
+
+  if (!base.square()) throw std::runtime_error("Mismatched matrix size for pow");
+  const size_type n = base.rows();
+  if (!k) return contiguous_matrix<T>::unity(n);
+
+  contiguous_matrix<T>               scratch{n, n};
+  contiguous_matrix<T, column_major> base_cols{n, n};
+
+  auto square = [&] {
+    base.relayout_into(base_cols);
+    mul(scratch, base, base_cols);
+    std::swap(base, scratch);
+  };
+
+  // Trailing zero bits only square, and the first set bit copies instead of multiplying by the identity.
+  for (; !(k & 1); k >>= 1) {
+    square();
+  }
+
+  contiguous_matrix<T> res = base;
+  while (k >>= 1) {
+    square();
+    if (k & 1) {
+      base.relayout_into(base_cols);
+      mul(scratch, res, base_cols);
+      std::swap(res, scratch);
+    }
+  }
+
+  return res;
+}
+
+} // namespace detail
+
+// mat^k with O(log k) products of the regular multiply kernel, dot products reduced with P.
+template <typename T, matrix_layout L, summation_policy P = default_summation>
+contiguous_matrix<T, L> pow(const contiguous_matrix<T, L> &mat, std::uint64_t k, P = {}) {
+  auto res = detail::pow_impl(mat.template relayout<row_major>(), k, [](auto &res, const auto &lhs, const auto &rhs) {
+    contiguous_matrix<T>::multiply_into(res, lhs, rhs, P{});
+  });
+  return res.template relayout<L>();
+}
+
+template <typename T> matrix<T> pow(const matrix<T> &mat, std::uint64_t k) {
+  contiguous_matrix<T> c_mat{mat.rows(), mat.cols()};
+  for (std::size_t i = 0; i < mat.rows(); ++i) {
+    std::copy(mat[i].begin(), mat[i].end(), c_mat[i].begin());
+  }
+  return matrix<T>{pow(c_mat, k)};
+}
+
+// mat^k with every entry taken modulo `modulus`, for linear recurrences over Z/mZ. Entries are reduced into
+// [0, modulus) first; products are accumulated in 64 bits and reduced only as often as needed to not overflow, which
+// is why the modulus is limited to 2^32.
+template <std::integral T, matrix_layout L>
+contiguous_matrix<T, L> pow_mod(const contiguous_matrix<T, L> &mat, std::uint64_t k, T modulus) {
+  using size_type = typename contiguous_matrix<T>::size_type;
+
+  if (modulus <= 0 || std::uint64_t(modulus) - 1 > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::invalid_argument("Modulus out of range for pow_mod");
+  }
+
+  const std::uint64_t m = modulus, max_product = (m - 1) * (m - 1);
+  const size_type     batch = (max_product ? (std::numeric_limits<std::uint64_t>::max() - m) / max_product
+                                           : std::numeric_limits<size_type>::max());
+
+  auto reduce = [m](T val) {
+    if constexpr (std::is_signed_v<T>) {
+      // The remainder is above -m, so adding m only when it is negative cannot overflow.
+      T rem = val % T(m);
+      return T(rem < 0 ? rem + T(m) : rem);
+    } else return T(val % m);
+  };
+
+  auto dot = [m, batch](const T *a, const T *b, size_type n) {
+    std::uint64_t acc = 0;
+    for (size_type i = 0; i < n;) {
+      for (size_type last = i + std::min(batch, n - i); i < last; ++i) {
+        acc += std::uint64_t(a[i]) * std::uint64_t(b[i]);
+      }
+      acc %= m;
+    }
+    return T(acc);
+  };
+
+  auto base = mat.template relayout<row_major>();
+  std::transform(base.begin(), base.end(), base.begin(), reduce);
+
+  auto res = detail::pow_impl(std::move(base), k, [&dot](auto &res, const auto &lhs, const auto &rhs) {
+    contiguous_matrix<T>::multiply_into(res, lhs, rhs, dot);
+  });
+  if (!k) std::transform(res.begin(), res.end(), res.begin(), reduce);
+  return res.template relayout<L>();
+}
+
+} // namespace linmath
+} // namespace throttle
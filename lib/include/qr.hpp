@@ -0,0 +1,338 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "contiguous_matrix.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace throttle {
+namespace linmath {
+
+// Householder QR, A = Q * R, of an m x n matrix with k = min(m, n) reflectors H_j = I - tau_j * v_j * v_j^T. R is
+// stored on and above the diagonal, v_j below it (its leading 1 is implicit), like LAPACK's geqrf.
+//
+// Columns are factored in panels of `block` columns. A panel is factored column by column, then its reflectors are
+// accumulated into the compact WY form H_j0 * ... * H_j0+b-1 = I - V * T * V^T with T upper triangular, and the rest
+// of the matrix is updated with three products V^T * C, T^T * W and V * W instead of b rank-1 updates. The update is
+// split between the pool threads by columns.
+template <std::floating_point T> class householder_qr {
+  using size_type = std::size_t;
+
+  contiguous_matrix<T> m_qr;
+  std::vector<T>       m_tau;
+
+  size_type rows() const { return m_qr.rows(); }
+  size_type cols() const { return m_qr.cols(); }
+  size_type reflectors() const { return std::min(rows(), cols()); }
+
+  T       &at(size_type i, size_type j) { return m_qr.data()[i * cols() + j]; }
+  const T &at(size_type i, size_type j) const { return m_qr.data()[i * cols() + j]; }
+
+  // Entry r of v_j, zero above its implicit leading 1.
+  T reflector(size_type r, size_type j) const { return (r > j ? at(r, j) : T(r == j)); }
+
+  // Reflectors of columns [j0, j0 + b) on columns [j0, j0 + b) only.
+  void factor_panel(size_type j0, size_type b) {
+    std::vector<T> w(b);
+    for (size_type j = j0; j < j0 + b; ++j) {
+      T alpha = at(j, j), sigma = 0;
+      for (size_type r = j + 1; r < rows(); ++r) {
+        sigma += at(r, j) * at(r, j);
+      }
+
+      if (sigma == T{}) {
+        m_tau[j] = T{};
+        continue;
+      }
+
+      T beta = -std::copysign(std::sqrt(alpha * alpha + sigma), alpha), scale = T{1} / (alpha - beta);
+      m_tau[j] = (beta - alpha) / beta;
+      for (size_type r = j + 1; r < rows(); ++r) {
+        at(r, j) *= scale;
+      }
+      at(j, j) = beta;
+
+      // w^T = v^T * A over the rest of the panel, row by row so that the inner loop is contiguous.
+      const size_type rest = j0 + b - (j + 1);
+      std::copy_n(&at(j, j + 1), rest, w.begin());
+      for (size_type r = j + 1; r < rows(); ++r) {
+        for (size_type c = 0; c < rest; ++c) {
+          w[c] += at(r, j) * at(r, j + 1 + c);
+        }
+      }
+      for (size_type r = j; r < rows(); ++r) {
+        T v_r = m_tau[j] * reflector(r, j);
+        for (size_type c = 0; c < rest; ++c) {
+          at(r, j + 1 + c) -= v_r * w[c];
+        }
+      }
+    }
+  }
+
+  // T of the panel, b x b row-major: T[i][i] = tau_i and T[0:i, i] = -tau_i * T[0:i, 0:i] * V[:, 0:i]^T * v_i.
+  std::vector<T> triangular_factor(size_type j0, size_type b) const {
+    std::vector<T> t(b * b), z(b);
+    for (size_type i = 0; i < b; ++i) {
+      const T tau = m_tau[j0 + i];
+      t[i * b + i] = tau;
+
+      std::fill_n(z.begin(), i, T{});
+      for (size_type r = j0 + i; r < rows(); ++r) {
+        T v_r = reflector(r, j0 + i);
+        for (size_type l = 0; l < i; ++l) {
+          z[l] += reflector(r, j0 + l) * v_r;
+        }
+      }
+      for (size_type l = 0; l < i; ++l) {
+        T sum = 0;
+        for (size_type p = l; p < i; ++p) {
+          sum += t[l * b + p] * z[p];
+        }
+        t[l * b + i] = -tau * sum;
+      }
+    }
+    return t;
+  }
+
+  // C = (I - V * op(T) * V^T) * C on rows [j0, m) of columns [c_first, c_last) of a row-major matrix with `ldc`
+  // columns; op(T) = T^T applies the transposed block reflector, as Q^T does.
+  void apply_block(size_type j0, size_type b, const std::vector<T> &t, T *c, size_type ldc, size_type c_first,
+                   size_type c_last, bool transpose) const {
+    const size_type work = (rows() - j0) * b;
+    concurrency::parallel_for(c_first, c_last, concurrency::grain_for(work), [&](size_type first, size_type last) {
+      const size_type width = last - first;
+      std::vector<T>  w(b * width);
+
+      // W = V^T * C
+      for (size_type r = j0; r < rows(); ++r) {
+        const T *c_row = c + r * ldc + first;
+        for (size_type i = 0; i < b && j0 + i <= r; ++i) {
+          T v_ri = reflector(r, j0 + i), *w_row = w.data() + i * width;
+          for (size_type cc = 0; cc < width; ++cc) {
+            w_row[cc] += v_ri * c_row[cc];
+          }
+        }
+      }
+
+      // W = op(T) * W in place; the order of rows keeps the entries that are still needed intact.
+      auto combine = [&w, width](size_type dst, size_type src, T coef) {
+        for (size_type cc = 0; cc < width; ++cc) {
+          w[dst * width + cc] += coef * w[src * width + cc];
+        }
+      };
+      auto scale = [&w, width](size_type row, T coef) {
+        for (size_type cc = 0; cc < width; ++cc) {
+          w[row * width + cc] *= coef;
+        }
+      };
+      if (transpose) {
+        for (size_type i = b; i-- > 0;) {
+          scale(i, t[i * b + i]);
+          for (size_type l = 0; l < i; ++l) {
+            combine(i, l, t[l * b + i]);
+          }
+        }
+      } else {
+        for (size_type i = 0; i < b; ++i) {
+          scale(i, t[i * b + i]);
+          for (size_type l = i + 1; l < b; ++l) {
+            combine(i, l, t[i * b + l]);
+          }
+        }
+      }
+
+      // C -= V * W
+      for (size_type r = j0; r < rows(); ++r) {
+        T *c_row = c + r * ldc + first;
+        for (size_type i = 0; i < b && j0 + i <= r; ++i) {
+          T        v_ri = reflector(r, j0 + i);
+          const T *w_row = w.data() + i * width;
+          for (size_type cc = 0; cc < width; ++cc) {
+            c_row[cc] -= v_ri * w_row[cc];
+          }
+        }
+      }
+    });
+  }
+
+  void factorize() {
+    for (size_type j0 = 0; j0 < reflectors(); j0 += block) {
+      const size_type b = std::min(block, reflectors() - j0);
+      factor_panel(j0, b);
+      if (j0 + b < cols()) {
+        apply_block(j0, b, triangular_factor(j0, b), m_qr.data(), cols(), j0 + b, cols(), true);
+      }
+    }
+  }
+
+public:
+  static constexpr size_type block = 32;
+
+  householder_qr(contiguous_matrix<T> mat) : m_qr{std::move(mat)}, m_tau(reflectors()) { factorize(); }
+
+  const contiguous_matrix<T> &factors() const { return m_qr; }
+  const std::vector<T>       &tau() const { return m_tau; }
+
+  // k x n upper trapezoidal factor.
+  contiguous_matrix<T> r() const {
+    contiguous_matrix<T> res{reflectors(), cols()};
+    for (size_type i = 0; i < reflectors(); ++i) {
+      std::copy(&at(i, i), &at(i, 0) + cols(), &res[i][i]);
+    }
+    return res;
+  }
+
+  // m x k factor with orthonormal columns, accumulated backwards panel by panel from the leading columns of I.
+  contiguous_matrix<T> q() const {
+    const size_type      k = reflectors();
+    contiguous_matrix<T> res{rows(), k};
+    for (size_type i = 0; i < k; ++i) {
+      res[i][i] = T{1};
+    }
+
+    // Columns before the panel are still unit vectors above it, which the panel does not touch.
+    for (size_type j0 = (k ? (k - 1) / block * block : 0); j0 < k; j0 -= block) {
+      const size_type b = std::min(block, k - j0);
+      apply_block(j0, b, triangular_factor(j0, b), res.data(), k, j0, k, false);
+      if (!j0) break;
+    }
+    return res;
+  }
+
+  // b = Q^T * b for b of length m.
+  void apply_qt(std::span<T> b) const {
+    if (b.size() != rows()) throw std::runtime_error("Mismatched vector size for QR");
+    for (size_type j = 0; j < reflectors(); ++j) {
+      T dot = b[j];
+      for (size_type r = j + 1; r < rows(); ++r) {
+        dot += at(r, j) * b[r];
+      }
+      dot *= m_tau[j];
+      b[j] -= dot;
+      for (size_type r = j + 1; r < rows(); ++r) {
+        b[r] -= dot * at(r, j);
+      }
+    }
+  }
+
+  // x minimizing |A * x - b|, for m >= n and A of full column rank. A diagonal entry of R below m * eps times the
+  // largest one is taken as rank deficiency.
+  std::vector<T> solve(std::span<const T> b) const {
+    if (rows() < cols()) throw std::runtime_error("Underdetermined system for least squares");
+    std::vector<T> qtb(b.begin(), b.end());
+    apply_qt(std::span<T>{qtb});
+
+    T max_diag = 0;
+    for (size_type i = 0; i < cols(); ++i) {
+      max_diag = std::max(max_diag, std::abs(at(i, i)));
+    }
+    const T tolerance = T(rows()) * std::numeric_limits<T>::epsilon() * max_diag;
+
+    std::vector<T> x(cols());
+    for (size_type i = cols(); i-- > 0;) {
+      if (std::abs(at(i, i)) <= tolerance) throw std::runtime_error("Rank deficient matrix for least squares");
+      T sum = qtb[i];
+      for (size_type j = i + 1; j < cols(); ++j) {
+        sum -= at(i, j) * x[j];
+      }
+      x[i] = sum / at(i, i);
+    }
+    return x;
+  }
+};
+
+// Tall-skinny QR: the rows are split into blocks that are factored independently in parallel, then the stacked n x n
+// R factors of the blocks are factored once more. The R of that last factorization is the R of the whole matrix (up
+// to the signs of its rows), and Q is kept implicitly as the block factorizations plus the top one. Only the small
+// stack is factored sequentially.
+template <std::floating_point T> class tsqr {
+  using size_type = std::size_t;
+
+  size_type                        m_rows, m_cols;
+  std::vector<size_type>           m_bounds; // Block i holds rows [m_bounds[i], m_bounds[i + 1])
+  std::vector<householder_qr<T>>   m_blocks;
+  std::optional<householder_qr<T>> m_top;
+
+public:
+  tsqr(const contiguous_matrix<T> &mat, size_type blocks = concurrency::thread_pool::instance().size() + 1)
+      : m_rows{mat.rows()}, m_cols{mat.cols()} {
+    if (!m_cols || m_rows < m_cols) throw std::runtime_error("Mismatched matrix size for TSQR");
+
+    const size_type count = std::clamp<size_type>(blocks, 1, m_rows / m_cols);
+    for (size_type i = 0; i <= count; ++i) {
+      m_bounds.push_back(m_rows * i / count);
+    }
+
+    std::vector<std::optional<householder_qr<T>>> factored(count);
+    concurrency::parallel_for(0, count, 1, [this, &mat, &factored](size_type first, size_type last) {
+      for (size_type i = first; i < last; ++i) {
+        const T *begin = mat.data() + m_bounds[i] * m_cols, *end = mat.data() + m_bounds[i + 1] * m_cols;
+        factored[i].emplace(contiguous_matrix<T>{m_bounds[i + 1] - m_bounds[i], m_cols, begin, end});
+      }
+    });
+    for (auto &qr : factored) {
+      m_blocks.push_back(std::move(*qr));
+    }
+
+    contiguous_matrix<T> stacked{count * m_cols, m_cols};
+    for (size_type i = 0; i < count; ++i) {
+      auto r = m_blocks[i].r();
+      std::copy(r.begin(), r.end(), stacked.data() + i * m_cols * m_cols);
+    }
+    m_top.emplace(std::move(stacked));
+  }
+
+  contiguous_matrix<T> r() const { return m_top->r(); }
+
+  // The stacked system [Q_i^T * b_i]_0:n has the same least squares solution as A * x = b.
+  std::vector<T> solve(std::span<const T> b) const {
+    if (b.size() != m_rows) throw std::runtime_error("Mismatched vector size for QR");
+
+    std::vector<T> stacked(m_blocks.size() * m_cols);
+    concurrency::parallel_for(0, m_blocks.size(), 1, [this, b, &stacked](size_type first, size_type last) {
+      for (size_type i = first; i < last; ++i) {
+        std::vector<T> slice(b.begin() + m_bounds[i], b.begin() + m_bounds[i + 1]);
+        m_blocks[i].apply_qt(std::span<T>{slice});
+        std::copy_n(slice.begin(), m_cols, stacked.begin() + i * m_cols);
+      }
+    });
+    return m_top->solve(stacked);
+  }
+};
+
+// Matrices at least this many times taller than wide are solved with TSQR.
+inline constexpr std::size_t tsqr_aspect_ratio = 16;
+
+template <std::floating_point T, matrix_layout L> householder_qr<T> qr(const contiguous_matrix<T, L> &mat) {
+  return householder_qr<T>{mat.template relayout<row_major>()};
+}
+
+template <std::floating_point T, matrix_layout L>
+std::vector<T> least_squares(const contiguous_matrix<T, L> &mat, std::span<const T> b) {
+  if (b.size() != mat.rows()) throw std::runtime_error("Mismatched vector size for least squares");
+  if (mat.cols() && mat.rows() >= tsqr_aspect_ratio * mat.cols()) {
+    return tsqr<T>{mat.template relayout<row_major>()}.solve(b);
+  }
+  return qr(mat).solve(b);
+}
+
+} // namespace linmath
+} // namespace throttle
@@ -0,0 +1,271 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "contiguous_matrix.hpp"
+#include "pivot.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+namespace throttle {
+namespace linmath {
+
+// LU factorization with complete pivoting, P * A * Q = L * U, of an m x n matrix. Elimination stops once every entry
+// of the remaining submatrix is within the tolerance; the number of steps taken is the numerical rank r, L is m x r
+// with unit diagonal and U is r x n. The default tolerance is max(m, n) * eps * max|A|.
+//
+// The next pivot is the largest entry of the updated submatrix, so every step would need a pass over it after the
+// update. Instead each worker keeps track of the largest entry while it updates its rows, and the search costs only a
+// reduction of the per-chunk maxima.
+template <std::floating_point T> class rank_revealing_lu {
+  using size_type = std::size_t;
+
+  struct candidate {
+    T         value = -1;
+    size_type row = 0, col = 0;
+
+    // Ties go to the smallest index so that the choice does not depend on how rows were split between threads.
+    bool better_than(const candidate &other) const {
+      return value > other.value || (value == other.value && std::pair{row, col} < std::pair{other.row, other.col});
+    }
+  };
+
+  contiguous_matrix<T>   m_lu;
+  std::vector<size_type> m_row_perm, m_col_perm; // Row i of P * A * Q is row m_row_perm[i] of A, column j is column
+                                                 // m_col_perm[j] of A.
+  size_type m_rank = 0;
+  T         m_tolerance;
+
+  size_type rows() const { return m_lu.rows(); }
+  size_type cols() const { return m_lu.cols(); }
+  T        *row_ptr(size_type i) { return m_lu.data() + i * cols(); }
+
+  // Largest magnitude in rows [first_row, m) and columns [first_col, n), without updating anything.
+  candidate search(size_type first_row, size_type first_col) {
+    candidate  best;
+    std::mutex mutex;
+    concurrency::parallel_for(first_row, rows(), concurrency::grain_for(cols() - first_col),
+                              [this, first_col, &best, &mutex](size_type first, size_type last) {
+                                candidate local;
+                                for (size_type i = first; i < last; ++i) {
+                                  const T  *row = row_ptr(i) + first_col;
+                                  size_type j = kernels::argmax_abs(row, cols() - first_col);
+                                  candidate cur{std::abs(row[j]), i, first_col + j};
+                                  if (cur.better_than(local)) local = cur;
+                                }
+                                std::lock_guard lock{mutex};
+                                if (local.better_than(best)) best = local;
+                              });
+    return best;
+  }
+
+  void swap_cols(size_type a, size_type b) {
+    if (a == b) return;
+    for (size_type i = 0; i < rows(); ++i) {
+      std::swap(row_ptr(i)[a], row_ptr(i)[b]);
+    }
+    std::swap(m_col_perm[a], m_col_perm[b]);
+  }
+
+  // Eliminate below pivot k and return the pivot for step k + 1.
+  candidate eliminate(size_type k) {
+    candidate  best;
+    std::mutex mutex;
+    const T   *pivot = row_ptr(k);
+    concurrency::parallel_for(k + 1, rows(), concurrency::grain_for(cols() - k),
+                              [this, k, pivot, &best, &mutex](size_type first, size_type last) {
+                                candidate local;
+                                for (size_type i = first; i < last; ++i) {
+                                  T        *row = row_ptr(i);
+                                  T         l_ik = (row[k] /= pivot[k]);
+                                  T         max_val = -1;
+                                  size_type max_col = k + 1;
+                                  for (size_type j = k + 1; j < cols(); ++j) {
+                                    row[j] -= l_ik * pivot[j];
+                                    if (std::abs(row[j]) > max_val) {
+                                      max_val = std::abs(row[j]);
+                                      max_col = j;
+                                    }
+                                  }
+                                  candidate cur{max_val, i, max_col};
+                                  if (cur.better_than(local)) local = cur;
+                                }
+                                std::lock_guard lock{mutex};
+                                if (local.better_than(best)) best = local;
+                              });
+    return best;
+  }
+
+  void factorize() {
+    const size_type steps = std::min(rows(), cols());
+    if (!steps) return;
+
+    candidate next = search(0, 0);
+    if (m_tolerance < T{}) {
+      m_tolerance = T(std::max(rows(), cols())) * std::numeric_limits<T>::epsilon() * next.value;
+    }
+
+    for (size_type k = 0; k < steps; ++k) {
+      if (next.value <= m_tolerance) break;
+
+      if (next.row != k) {
+        std::swap_ranges(row_ptr(k), row_ptr(k) + cols(), row_ptr(next.row));
+        std::swap(m_row_perm[k], m_row_perm[next.row]);
+      }
+      swap_cols(k, next.col);
+      ++m_rank;
+
+      if (k + 1 < steps) next = eliminate(k);
+      else eliminate(k);
+    }
+  }
+
+  // X = U11^-1 * U12, r x (n - r). Rows are solved bottom up, columns of X are independent.
+  std::vector<T> solve_upper() const {
+    const size_type r = m_rank, width = cols() - r;
+    const T        *u = m_lu.data();
+    std::vector<T>  x(r * width);
+
+    concurrency::parallel_for(
+        0, width, concurrency::grain_for(r * r), [this, r, width, u, &x](size_type first, size_type last) {
+          for (size_type i = r; i-- > 0;) {
+            T *x_row = x.data() + i * width;
+            for (size_type t = first; t < last; ++t) {
+              x_row[t] = u[i * cols() + r + t];
+            }
+            for (size_type j = i + 1; j < r; ++j) {
+              const T  u_ij = u[i * cols() + j], *x_other = x.data() + j * width;
+              for (size_type t = first; t < last; ++t) {
+                x_row[t] -= u_ij * x_other[t];
+              }
+            }
+            for (size_type t = first; t < last; ++t) {
+              x_row[t] /= u[i * cols() + i];
+            }
+          }
+        });
+
+    return x;
+  }
+
+public:
+  rank_revealing_lu(contiguous_matrix<T> mat, std::optional<T> tolerance = std::nullopt)
+      : m_lu{std::move(mat)}, m_row_perm(m_lu.rows()), m_col_perm(m_lu.cols()), m_tolerance{tolerance.value_or(-1)} {
+    std::iota(m_row_perm.begin(), m_row_perm.end(), size_type{0});
+    std::iota(m_col_perm.begin(), m_col_perm.end(), size_type{0});
+    factorize();
+  }
+
+  size_type rank() const { return m_rank; }
+  size_type nullity() const { return cols() - m_rank; }
+  T         tolerance() const { return m_tolerance; }
+
+  // L and U in one buffer; only the leading r columns of L and the leading r rows of U are meaningful.
+  const contiguous_matrix<T>   &factors() const { return m_lu; }
+  const std::vector<size_type> &row_permutation() const { return m_row_perm; }
+  const std::vector<size_type> &col_permutation() const { return m_col_perm; }
+
+  // n x (n - r) matrix whose columns span the null space. With Q^T * x = (z1, z2), A * x = 0 is U11 * z1 + U12 * z2 = 0,
+  // so column t is z2 = e_t, z1 = -U11^-1 * U12 * e_t, permuted back by Q.
+  contiguous_matrix<T> nullspace() const {
+    const size_type      r = m_rank, width = cols() - r;
+    auto                 x = solve_upper();
+    contiguous_matrix<T> res{cols(), width};
+
+    for (size_type t = 0; t < width; ++t) {
+      res[m_col_perm[r + t]][t] = T{1};
+      for (size_type i = 0; i < r; ++i) {
+        res[m_col_perm[i]][t] = -x[i * width + t];
+      }
+    }
+    return res;
+  }
+
+  // Reduced row echelon form, m x n with rows below the rank zero. The rows of [I, U11^-1 * U12] * Q^T span the row
+  // space, but complete pivoting need not have chosen the leftmost independent columns, so they are brought into
+  // echelon form by Gauss-Jordan with partial pivoting, taking pivot columns from left to right.
+  contiguous_matrix<T> rref() const {
+    const size_type      r = m_rank, width = cols() - r;
+    auto                 x = solve_upper();
+    contiguous_matrix<T> basis{r, cols()};
+
+    T max_abs = 1;
+    for (size_type i = 0; i < r; ++i) {
+      basis[i][m_col_perm[i]] = T{1};
+      for (size_type t = 0; t < width; ++t) {
+        basis[i][m_col_perm[r + t]] = x[i * width + t];
+        max_abs = std::max(max_abs, std::abs(x[i * width + t]));
+      }
+    }
+
+    const T   tolerance = T(std::max(r, cols())) * std::numeric_limits<T>::epsilon() * max_abs;
+    size_type row = 0;
+    for (size_type col = 0; col < cols() && row < r; ++col) {
+      auto [pivot_row, pivot] = basis.max_in_col_greater_eq(col, row);
+      if (std::abs(pivot) <= tolerance) continue;
+
+      T *pivot_ptr = basis.data() + pivot_row * cols();
+      if (pivot_row != row) {
+        std::swap_ranges(pivot_ptr, pivot_ptr + cols(), basis.data() + row * cols());
+        pivot_ptr = basis.data() + row * cols();
+      }
+      for (size_type j = 0; j < cols(); ++j) {
+        pivot_ptr[j] /= pivot;
+      }
+
+      concurrency::parallel_for(0, r, concurrency::grain_for(cols()),
+                                [&basis, pivot_ptr, row, col, this](size_type first, size_type last) {
+                                  for (size_type i = first; i < last; ++i) {
+                                    if (i == row) continue;
+                                    T *other = basis.data() + i * cols();
+                                    T  coef = other[col];
+                                    for (size_type j = 0; j < cols(); ++j) {
+                                      other[j] -= coef * pivot_ptr[j];
+                                    }
+                                    other[col] = T{};
+                                  }
+                                });
+      pivot_ptr[col] = T{1};
+      ++row;
+    }
+
+    contiguous_matrix<T> res{rows(), cols()};
+    std::copy(basis.data(), basis.data() + r * cols(), res.data());
+    return res;
+  }
+};
+
+template <std::floating_point T, matrix_layout L>
+std::size_t rank(const contiguous_matrix<T, L> &mat, std::optional<T> tolerance = std::nullopt) {
+  return rank_revealing_lu<T>{mat.template relayout<row_major>(), tolerance}.rank();
+}
+
+template <std::floating_point T, matrix_layout L>
+contiguous_matrix<T, L> rref(const contiguous_matrix<T, L> &mat, std::optional<T> tolerance = std::nullopt) {
+  return rank_revealing_lu<T>{mat.template relayout<row_major>(), tolerance}.rref().template relayout<L>();
+}
+
+template <std::floating_point T, matrix_layout L>
+contiguous_matrix<T> nullspace(const contiguous_matrix<T, L> &mat, std::optional<T> tolerance = std::nullopt) {
+  return rank_revealing_lu<T>{mat.template relayout<row_major>(), tolerance}.nullspace();
+}
+
+} // namespace linmath
+} // namespace throttle
@@ -0,0 +1,184 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "equal.hpp"
+
+#include <compare>
+#include <concepts>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+namespace throttle {
+namespace linmath {
+
+// Exact fraction num / den with den > 0. Results of arithmetic are not reduced: a gcd per operation would dominate
+// elimination, and most intermediate values are used once. Operations are done in checked arithmetic instead; when
+// one overflows, the operands are reduced and it is retried, and only if that overflows too std::overflow_error is
+// thrown. Comparisons do not reduce unless cross-multiplication overflows. Equal values may thus have different
+// numerators; numerator() and denominator() give the reduced ones.
+template <std::signed_integral Int> class rational {
+  Int m_num = 0, m_den = 1;
+
+  struct unchecked_tag {};
+  constexpr rational(Int num, Int den, unchecked_tag) : m_num{num}, m_den{den} {}
+
+  static constexpr bool mul(Int a, Int b, Int &res) { return !__builtin_mul_overflow(a, b, &res); }
+  static constexpr bool add(Int a, Int b, Int &res) { return !__builtin_add_overflow(a, b, &res); }
+  static constexpr bool sub(Int a, Int b, Int &res) { return !__builtin_sub_overflow(a, b, &res); }
+
+  [[noreturn]] static void overflow() { throw std::overflow_error("Rational arithmetic overflow"); }
+
+  // lhs + rhs or lhs - rhs. Equal denominators are kept as they are, which keeps integer-valued operands integers.
+  static constexpr rational add_impl(const rational &lhs, const rational &rhs, bool subtract) {
+    auto combine = [subtract](Int lhs_num, Int lhs_scale, Int rhs_num, Int rhs_scale, Int &res) {
+      Int first, second;
+      return mul(lhs_num, lhs_scale, first) && mul(rhs_num, rhs_scale, second) &&
+             (subtract ? sub(first, second, res) : add(first, second, res));
+    };
+
+    if (lhs.m_den == rhs.m_den) {
+      Int num;
+      if (subtract ? sub(lhs.m_num, rhs.m_num, num) : add(lhs.m_num, rhs.m_num, num)) {
+        return rational{num, lhs.m_den, unchecked_tag{}};
+      }
+    } else {
+      Int num, den;
+      if (combine(lhs.m_num, rhs.m_den, rhs.m_num, lhs.m_den, num) && mul(lhs.m_den, rhs.m_den, den)) {
+        return rational{num, den, unchecked_tag{}};
+      }
+    }
+
+    // Reduced operands over the least common denominator.
+    rational a = lhs.normalized(), b = rhs.normalized();
+    Int      g = std::gcd(a.m_den, b.m_den), num, den;
+    if (!combine(a.m_num, b.m_den / g, b.m_num, a.m_den / g, num) || !mul(a.m_den / g, b.m_den, den)) overflow();
+    return rational{num, den, unchecked_tag{}}.normalized();
+  }
+
+  static constexpr rational mul_impl(const rational &lhs, const rational &rhs) {
+    Int num, den;
+    if (mul(lhs.m_num, rhs.m_num, num) && mul(lhs.m_den, rhs.m_den, den)) return rational{num, den, unchecked_tag{}};
+
+    // Reduced operands have no common factors within a fraction, so cancelling across them gives a reduced product.
+    rational a = lhs.normalized(), b = rhs.normalized();
+    Int      g1 = std::gcd(a.m_num, b.m_den), g2 = std::gcd(b.m_num, a.m_den);
+    if (!mul(a.m_num / g1, b.m_num / g2, num) || !mul(a.m_den / g2, b.m_den / g1, den)) overflow();
+    return rational{num, den, unchecked_tag{}};
+  }
+
+  // Sign of lhs - rhs for reduced fractions too large to cross-multiply, by comparing continued fraction expansions.
+  static constexpr int compare_slow(Int a, Int b, Int c, Int d) {
+    bool flipped = false;
+    for (;;) {
+      Int q1 = a / b, r1 = a % b, q2 = c / d, r2 = c % d;
+      if (r1 < 0) r1 += b, --q1;
+      if (r2 < 0) r2 += d, --q2;
+      int res = (q1 < q2 ? -1 : (q1 > q2 ? 1 : 0));
+      if (!res) {
+        if (r1 == 0 || r2 == 0) res = (r1 == r2 ? 0 : (r1 == 0 ? -1 : 1));
+        else {
+          // r1 / b versus r2 / d is the reverse of b / r1 versus d / r2.
+          a = b, b = r1, c = d, d = r2;
+          flipped = !flipped;
+          continue;
+        }
+      }
+      return (flipped ? -res : res);
+    }
+  }
+
+public:
+  constexpr rational() = default;
+  constexpr rational(Int num) : m_num{num} {}
+
+  constexpr rational(Int num, Int den) : m_num{num}, m_den{den} {
+    if (den == 0) throw std::invalid_argument("Zero denominator");
+    if (den < 0) *this = flip();
+  }
+
+  // Lowest terms.
+  constexpr rational normalized() const {
+    Int g = std::gcd(m_num, m_den);
+    return (g > 1 ? rational{m_num / g, m_den / g, unchecked_tag{}} : *this);
+  }
+
+  constexpr void normalize() { *this = normalized(); }
+
+  constexpr Int numerator() const { return normalized().m_num; }
+  constexpr Int denominator() const { return normalized().m_den; }
+
+  template <std::floating_point F> constexpr explicit operator F() const { return F(m_num) / F(m_den); }
+
+  constexpr rational operator-() const {
+    Int num;
+    if (!sub(0, m_num, num)) overflow();
+    return rational{num, m_den, unchecked_tag{}};
+  }
+
+  constexpr rational &operator+=(const rational &rhs) { return *this = add_impl(*this, rhs, false); }
+  constexpr rational &operator-=(const rational &rhs) { return *this = add_impl(*this, rhs, true); }
+  constexpr rational &operator*=(const rational &rhs) { return *this = mul_impl(*this, rhs); }
+  constexpr rational &operator/=(const rational &rhs) { return *this = mul_impl(*this, rhs.inverse()); }
+
+  constexpr rational inverse() const {
+    if (m_num == 0) throw std::invalid_argument("Division by zero");
+    return (m_num > 0 ? rational{m_den, m_num, unchecked_tag{}} : rational{m_den, m_num});
+  }
+
+  friend constexpr rational operator+(rational lhs, const rational &rhs) { return lhs += rhs; }
+  friend constexpr rational operator-(rational lhs, const rational &rhs) { return lhs -= rhs; }
+  friend constexpr rational operator*(rational lhs, const rational &rhs) { return lhs *= rhs; }
+  friend constexpr rational operator/(rational lhs, const rational &rhs) { return lhs /= rhs; }
+
+  friend constexpr bool operator==(const rational &lhs, const rational &rhs) {
+    if (lhs.m_den == rhs.m_den) return lhs.m_num == rhs.m_num;
+    auto a = lhs.normalized(), b = rhs.normalized();
+    return a.m_num == b.m_num && a.m_den == b.m_den;
+  }
+
+  friend constexpr std::strong_ordering operator<=>(const rational &lhs, const rational &rhs) {
+    Int first, second;
+    if (mul(lhs.m_num, rhs.m_den, first) && mul(rhs.m_num, lhs.m_den, second)) return first <=> second;
+
+    auto a = lhs.normalized(), b = rhs.normalized();
+    return compare_slow(a.m_num, a.m_den, b.m_num, b.m_den) <=> 0;
+  }
+
+  friend std::ostream &operator<<(std::ostream &os, const rational &val) {
+    auto reduced = val.normalized();
+    os << reduced.m_num;
+    if (reduced.m_den != 1) os << "/" << reduced.m_den;
+    return os;
+  }
+
+private:
+  // Same value with both signs flipped, to make a negative denominator positive. If the denominator is the most
+  // negative Int, reducing may make room.
+  constexpr rational flip() const {
+    Int num, den;
+    if (sub(0, m_num, num) && sub(0, m_den, den)) return rational{num, den, unchecked_tag{}};
+
+    Int g = std::gcd(m_num, m_den);
+    if (g == 1 || !sub(0, m_num / g, num) || !sub(0, m_den / g, den)) overflow();
+    return rational{num, den, unchecked_tag{}};
+  }
+};
+
+} // namespace linmath
+
+// Rationals are exact, so matrices of them compare exactly.
+template <std::signed_integral Int> struct default_precision<linmath::rational<Int>> {
+  static constexpr linmath::rational<Int> m_prec{};
+};
+
+} // namespace throttle
@@ -0,0 +1,148 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "pivot.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace throttle {
+namespace linmath {
+namespace kernels {
+
+// Determinants of matrices up to this size skip the general elimination. The matrix is copied into a local array and
+// the kernel for its size is fully unrolled: cofactor expansion up to 4, elimination above that. No heap allocations.
+inline constexpr std::size_t max_small_determinant = 8;
+
+namespace detail {
+
+template <typename F, std::size_t... I> constexpr void unroll_impl(F &f, std::index_sequence<I...>) {
+  (f(std::integral_constant<std::size_t, I>{}), ...);
+}
+
+// f(integral_constant<0>), ..., f(integral_constant<N - 1>), so that indices are compile-time constants in the body.
+template <std::size_t N, typename F> constexpr void unroll(F &&f) { unroll_impl(f, std::make_index_sequence<N>{}); }
+
+template <typename T> constexpr T det2(T a00, T a01, T a10, T a11) { return a00 * a11 - a01 * a10; }
+
+template <typename T> constexpr T cofactor_det(const T (&a)[2][2]) { return det2(a[0][0], a[0][1], a[1][0], a[1][1]); }
+
+template <typename T> constexpr T cofactor_det(const T (&a)[3][3]) {
+  return a[0][0] * det2(a[1][1], a[1][2], a[2][1], a[2][2]) - a[0][1] * det2(a[1][0], a[1][2], a[2][0], a[2][2]) +
+         a[0][2] * det2(a[1][0], a[1][1], a[2][0], a[2][1]);
+}
+
+// Laplace expansion along the top two rows: 2x2 minors of the top rows times complementary minors of the bottom ones.
+template <typename T> constexpr T cofactor_det(const T (&a)[4][4]) {
+  T s0 = det2(a[0][0], a[0][1], a[1][0], a[1][1]), c5 = det2(a[2][2], a[2][3], a[3][2], a[3][3]);
+  T s1 = det2(a[0][0], a[0][2], a[1][0], a[1][2]), c4 = det2(a[2][1], a[2][3], a[3][1], a[3][3]);
+  T s2 = det2(a[0][0], a[0][3], a[1][0], a[1][3]), c3 = det2(a[2][1], a[2][2], a[3][1], a[3][2]);
+  T s3 = det2(a[0][1], a[0][2], a[1][1], a[1][2]), c2 = det2(a[2][0], a[2][3], a[3][0], a[3][3]);
+  T s4 = det2(a[0][1], a[0][3], a[1][1], a[1][3]), c1 = det2(a[2][0], a[2][2], a[3][0], a[3][2]);
+  T s5 = det2(a[0][2], a[0][3], a[1][2], a[1][3]), c0 = det2(a[2][0], a[2][1], a[3][0], a[3][1]);
+  return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+template <std::size_t N, typename T> constexpr void swap_rows(T (&a)[N][N], std::size_t x, std::size_t y) {
+  unroll<N>([&](auto j) { std::swap(a[x][j], a[y][j]); });
+}
+
+// Same elimination as the general determinant: partial pivoting on the largest magnitude for floating point types,
+// fraction-free Bareiss with the first non-zero pivot for other rings. Only the pivot row index is known at run time.
+template <std::size_t N, typename T> constexpr T elimination_det(T (&a)[N][N]) {
+  bool negate = false, singular = false;
+  T    prev{1};
+
+  unroll<N - 1>([&](auto k_) {
+    constexpr std::size_t k = decltype(k_)::value;
+    if (singular) return;
+
+    std::size_t pivot = k;
+    if constexpr (std::floating_point<T>) {
+      unroll<N - k - 1>([&](auto i_) {
+        constexpr std::size_t i = k + 1 + decltype(i_)::value;
+        if (magnitude(a[pivot][k]) < magnitude(a[i][k])) pivot = i;
+      });
+    } else {
+      unroll<N - k - 1>([&](auto i_) {
+        constexpr std::size_t i = k + 1 + decltype(i_)::value;
+        if (a[pivot][k] == T{}) pivot = i;
+      });
+    }
+    if (a[pivot][k] == T{}) {
+      singular = true;
+      return;
+    }
+    if (pivot != k) {
+      swap_rows(a, pivot, k);
+      negate = !negate;
+    }
+
+    unroll<N - k - 1>([&](auto i_) {
+      constexpr std::size_t i = k + 1 + decltype(i_)::value;
+      if constexpr (std::floating_point<T>) {
+        T coef = a[i][k] / a[k][k];
+        unroll<N - k - 1>([&](auto j_) {
+          constexpr std::size_t j = k + 1 + decltype(j_)::value;
+          a[i][j] -= coef * a[k][j];
+        });
+      } else {
+        unroll<N - k - 1>([&](auto j_) {
+          constexpr std::size_t j = k + 1 + decltype(j_)::value;
+          a[i][j] = (a[k][k] * a[i][j] - a[i][k] * a[k][j]) / prev;
+        });
+      }
+    });
+    prev = a[k][k];
+  });
+
+  if (singular) return T{};
+
+  T det;
+  if constexpr (std::floating_point<T>) {
+    det = T{1};
+    unroll<N>([&](auto i) { det *= a[i][i]; });
+  } else {
+    det = a[N - 1][N - 1];
+  }
+  return (negate ? T{} - det : det);
+}
+
+template <std::size_t N, typename T, typename F> constexpr T small_determinant_impl(F &get) {
+  T a[N][N];
+  unroll<N>([&](auto i) { unroll<N>([&](auto j) { a[i][j] = get(i, j); }); });
+
+  if constexpr (N <= 4) return cofactor_det(a);
+  else return elimination_det(a);
+}
+
+} // namespace detail
+
+// Determinant of the n x n matrix with elements get(i, j), for 2 <= n <= max_small_determinant.
+template <typename T, typename F> constexpr T small_determinant(std::size_t n, F get) {
+  switch (n) {
+  case 2: return detail::small_determinant_impl<2, T>(get);
+  case 3: return detail::small_determinant_impl<3, T>(get);
+  case 4: return detail::small_determinant_impl<4, T>(get);
+  case 5: return detail::small_determinant_impl<5, T>(get);
+  case 6: return detail::small_determinant_impl<6, T>(get);
+  case 7: return detail::small_determinant_impl<7, T>(get);
+  case 8: return detail::small_determinant_impl<8, T>(get);
+  }
+  return T{};
+}
+
+} // namespace kernels
+} // namespace linmath
+} // namespace throttle
@@ -0,0 +1,224 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "contiguous_matrix.hpp"
+#include "summation.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace throttle {
+namespace linmath {
+
+// Builders for Kronecker products, block-diagonal matrices and concatenations. They write straight into the buffer of
+// the result a contiguous run at a time instead of going through operator[] proxies.
+//
+// The kernels below work on row-major buffers. A column-major buffer is the row-major buffer of the transposed matrix,
+// and (A ⊗ B)^T = A^T ⊗ B^T, so column-major matrices reuse them with rows and columns swapped. Tiled matrices are
+// built in row-major order and relaid once at the end.
+
+namespace detail {
+
+template <typename T>
+void kron_rows(T *res, const T *a, std::size_t a_rows, std::size_t a_cols, const T *b, std::size_t b_rows,
+               std::size_t b_cols) {
+  const std::size_t res_cols = a_cols * b_cols;
+  concurrency::parallel_for(0, a_rows * b_rows, concurrency::grain_for(res_cols),
+                            [=](std::size_t first, std::size_t last) {
+                              for (std::size_t r = first; r < last; ++r) {
+                                const T *a_row = a + (r / b_rows) * a_cols, *b_row = b + (r % b_rows) * b_cols;
+                                T       *out = res + r * res_cols;
+                                for (std::size_t j = 0; j < a_cols; ++j, out += b_cols) {
+                                  const T scale = a_row[j];
+                                  for (std::size_t l = 0; l < b_cols; ++l) {
+                                    out[l] = scale * b_row[l];
+                                  }
+                                }
+                              }
+                            });
+}
+
+// Copy `block` into `res` with its top left corner at (row, col).
+template <typename T, matrix_layout L>
+void place(contiguous_matrix<T, L> &res, const contiguous_matrix<T, L> &block, std::size_t row, std::size_t col) {
+  constexpr bool by_rows = std::same_as<L, row_major>;
+  std::size_t    lines = (by_rows ? block.rows() : block.cols()), length = (by_rows ? block.cols() : block.rows());
+  std::size_t    stride = (by_rows ? res.cols() : res.rows());
+  T             *out = res.data() + (by_rows ? row * stride + col : col * stride + row);
+
+  if (length == stride) {
+    std::copy_n(block.data(), lines * length, out);
+    return;
+  }
+
+  for (std::size_t i = 0; i < lines; ++i) {
+    std::copy_n(block.data() + i * length, length, out + i * stride);
+  }
+}
+
+enum class arrangement { horizontal, vertical, diagonal };
+
+template <typename T, matrix_layout L>
+contiguous_matrix<T, L> assemble(std::span<const contiguous_matrix<T, L> *const> blocks, arrangement how) {
+  if constexpr (is_tiled_layout<L>::value) {
+    std::vector<contiguous_matrix<T>>        copies;
+    std::vector<const contiguous_matrix<T> *> pointers;
+    copies.reserve(blocks.size());
+    for (const auto *block : blocks) {
+      pointers.push_back(&copies.emplace_back(block->template relayout<row_major>()));
+    }
+    return assemble<T, row_major>(pointers, how).template relayout<L>();
+  } else {
+    std::size_t rows = 0, cols = 0;
+    for (const auto *block : blocks) {
+      if (how == arrangement::horizontal && block->rows() != blocks.front()->rows()) {
+        throw std::runtime_error("Mismatched matrix size for concatenation");
+      }
+      if (how == arrangement::vertical && block->cols() != blocks.front()->cols()) {
+        throw std::runtime_error("Mismatched matrix size for concatenation");
+      }
+      rows = (how == arrangement::horizontal ? block->rows() : rows + block->rows());
+      cols = (how == arrangement::vertical ? block->cols() : cols + block->cols());
+    }
+
+    contiguous_matrix<T, L> res{rows, cols};
+    std::size_t             row = 0, col = 0;
+    for (const auto *block : blocks) {
+      place(res, *block, row, col);
+      if (how != arrangement::vertical) col += block->cols();
+      if (how != arrangement::horizontal) row += block->rows();
+    }
+    return res;
+  }
+}
+
+} // namespace detail
+
+// res = A ⊗ B into an existing matrix of size (a.rows() * b.rows()) x (a.cols() * b.cols()).
+template <typename T, matrix_layout L>
+void kron_into(contiguous_matrix<T, L> &res, const contiguous_matrix<T, L> &a, const contiguous_matrix<T, L> &b) {
+  if (res.rows() != a.rows() * b.rows() || res.cols() != a.cols() * b.cols()) {
+    throw std::runtime_error("Mismatched matrix size for kronecker product");
+  }
+
+  if constexpr (is_tiled_layout<L>::value) {
+    contiguous_matrix<T> flat{res.rows(), res.cols()};
+    kron_into(flat, a.template relayout<row_major>(), b.template relayout<row_major>());
+    flat.relayout_into(res);
+  } else if constexpr (std::same_as<L, column_major>) {
+    detail::kron_rows(res.data(), a.data(), a.cols(), a.rows(), b.data(), b.cols(), b.rows());
+  } else {
+    detail::kron_rows(res.data(), a.data(), a.rows(), a.cols(), b.data(), b.rows(), b.cols());
+  }
+}
+
+template <typename T, matrix_layout L>
+contiguous_matrix<T, L> kron(const contiguous_matrix<T, L> &a, const contiguous_matrix<T, L> &b) {
+  contiguous_matrix<T, L> res{a.rows() * b.rows(), a.cols() * b.cols()};
+  kron_into(res, a, b);
+  return res;
+}
+
+// Blocks side by side; all of them need the same number of rows.
+template <typename T, matrix_layout L, std::same_as<contiguous_matrix<T, L>>... Rest>
+contiguous_matrix<T, L> hcat(const contiguous_matrix<T, L> &first, const Rest &...rest) {
+  const contiguous_matrix<T, L> *blocks[] = {&first, &rest...};
+  return detail::assemble<T, L>(blocks, detail::arrangement::horizontal);
+}
+
+// Blocks on top of each other; all of them need the same number of columns.
+template <typename T, matrix_layout L, std::same_as<contiguous_matrix<T, L>>... Rest>
+contiguous_matrix<T, L> vcat(const contiguous_matrix<T, L> &first, const Rest &...rest) {
+  const contiguous_matrix<T, L> *blocks[] = {&first, &rest...};
+  return detail::assemble<T, L>(blocks, detail::arrangement::vertical);
+}
+
+// Blocks along the diagonal, zero elsewhere. Blocks need not be square.
+template <typename T, matrix_layout L, std::same_as<contiguous_matrix<T, L>>... Rest>
+contiguous_matrix<T, L> block_diag(const contiguous_matrix<T, L> &first, const Rest &...rest) {
+  const contiguous_matrix<T, L> *blocks[] = {&first, &rest...};
+  return detail::assemble<T, L>(blocks, detail::arrangement::diagonal);
+}
+
+// A ⊗ B without forming it. Only references to the factors are kept, so they have to outlive the view.
+//
+// With x cut into rows of X (a.cols() x b.cols()), (A ⊗ B) * x is A * X * B^T read row by row. The product is taken in
+// that order, which costs O(n * p * (q + m)) for A m x n and B p x q instead of the O(m * n * p * q) of the full
+// matrix, and both steps are split by rows between the pool threads.
+template <typename T> class kronecker_view {
+  using size_type = std::size_t;
+
+  const contiguous_matrix<T> &m_a;
+  const contiguous_matrix<T> &m_b;
+
+public:
+  kronecker_view(const contiguous_matrix<T> &a, const contiguous_matrix<T> &b) : m_a{a}, m_b{b} {}
+
+  size_type rows() const { return m_a.rows() * m_b.rows(); }
+  size_type cols() const { return m_a.cols() * m_b.cols(); }
+
+  T operator()(size_type row, size_type col) const {
+    return m_a[row / m_b.rows()][col / m_b.cols()] * m_b[row % m_b.rows()][col % m_b.cols()];
+  }
+
+  // y = (A ⊗ B) * x into a span of size rows().
+  template <summation_policy P = default_summation>
+  void multiply_into(std::span<const T> x, std::span<T> y, P = {}) const {
+    if (x.size() != cols() || y.size() != rows()) {
+      throw std::runtime_error("Mismatched matrix size for kronecker product");
+    }
+
+    const size_type m = m_a.rows(), n = m_a.cols(), p = m_b.rows(), q = m_b.cols();
+    const T        *a = m_a.data(), *b = m_b.data(), *xs = x.data();
+
+    // W = X * B^T, n x p: every entry is a dot product of two contiguous rows.
+    std::vector<T> w(n * p);
+    concurrency::parallel_for(0, n, concurrency::grain_for(p * q), [&w, xs, b, p, q](size_type first, size_type last) {
+      for (size_type j = first; j < last; ++j) {
+        for (size_type k = 0; k < p; ++k) {
+          w[j * p + k] = P::dot(xs + j * q, b + k * q, q);
+        }
+      }
+    });
+
+    // Y = A * W, m x p, accumulated row by row.
+    T *ys = y.data();
+    concurrency::parallel_for(0, m, concurrency::grain_for(n * p), [&w, a, ys, n, p](size_type first, size_type last) {
+      for (size_type i = first; i < last; ++i) {
+        T *out = ys + i * p;
+        std::fill(out, out + p, T{});
+        for (size_type j = 0; j < n; ++j) {
+          const T  scale = a[i * n + j];
+          const T *w_row = w.data() + j * p;
+          for (size_type k = 0; k < p; ++k) {
+            out[k] += scale * w_row[k];
+          }
+        }
+      }
+    });
+  }
+
+  template <summation_policy P = default_summation>
+  std::vector<T> multiply(std::span<const T> x, P policy = {}) const {
+    std::vector<T> y(rows());
+    multiply_into(x, std::span<T>{y}, policy);
+    return y;
+  }
+};
+
+} // namespace linmath
+} // namespace throttle
@@ -0,0 +1,147 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "pivot.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+
+namespace throttle {
+namespace linmath {
+
+// Reduction policies for sums and dot products. sum(n, term) adds up term(0), ..., term(n - 1); the term is a lambda
+// so that it gets inlined into the loop. Error bounds are for floating point types, integers come out exact with all
+// of them.
+
+// Strict left to right order. The compiler may not reassociate, so the loop runs on a single dependency chain.
+// Error grows as O(n * eps).
+struct sequential_summation {
+  template <typename T, typename F> static constexpr T sum(std::size_t n, F term) {
+    T acc{};
+    for (std::size_t i = 0; i < n; ++i) {
+      acc += term(i);
+    }
+    return acc;
+  }
+
+  template <typename T> static constexpr T dot(const T *a, const T *b, std::size_t n) {
+    return sum<T>(n, [a, b](std::size_t i) { return a[i] * b[i]; });
+  }
+};
+
+// Independent accumulators, one per SIMD lane, combined pairwise at the end. Vectorizes, and the error drops to
+// O(n / lanes * eps).
+struct lane_summation {
+  static constexpr std::size_t lanes = 8;
+
+  template <typename T, typename F> static constexpr T sum(std::size_t n, F term) {
+    T           acc[lanes] = {};
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+      for (std::size_t l = 0; l < lanes; ++l) {
+        acc[l] += term(i + l);
+      }
+    }
+    for (std::size_t l = 0; l < n - i; ++l) {
+      acc[l] += term(i + l);
+    }
+
+    for (std::size_t width = lanes / 2; width; width /= 2) {
+      for (std::size_t l = 0; l < width; ++l) {
+        acc[l] += acc[l + width];
+      }
+    }
+    return acc[0];
+  }
+
+  template <typename T> static constexpr T dot(const T *a, const T *b, std::size_t n) {
+    return sum<T>(n, [a, b](std::size_t i) { return a[i] * b[i]; });
+  }
+};
+
+// Recursive halving down to blocks that are summed with lanes. Error is O(log(n) * eps) at the speed of the lane
+// version; block boundaries stay multiples of the block size so that every leaf runs full vectors.
+struct pairwise_summation {
+  static constexpr std::size_t block = 128;
+
+  template <typename T, typename F> static constexpr T sum(std::size_t n, F term) { return sum_range<T>(0, n, term); }
+
+  template <typename T> static constexpr T dot(const T *a, const T *b, std::size_t n) {
+    return sum<T>(n, [a, b](std::size_t i) { return a[i] * b[i]; });
+  }
+
+private:
+  template <typename T, typename F> static constexpr T sum_range(std::size_t first, std::size_t last, F &term) {
+    if (last - first <= block) {
+      return lane_summation::sum<T>(last - first, [first, &term](std::size_t i) { return term(first + i); });
+    }
+    std::size_t middle = first + std::max(block, (last - first) / 2 / block * block);
+    return sum_range<T>(first, middle, term) + sum_range<T>(middle, last, term);
+  }
+};
+
+// Neumaier's variant of Kahan summation, one compensated accumulator per lane. The error is about 2 * eps relative to
+// the sum of magnitudes plus a second order term of n * eps^2, so it does not depend on n until n * eps approaches one.
+// Roughly four times the work of lane_summation. Products in a dot product are still rounded before they are summed.
+struct compensated_summation {
+  static constexpr std::size_t lanes = 8;
+
+  template <typename T, typename F> static constexpr T sum(std::size_t n, F term) {
+    if constexpr (!std::floating_point<T>) {
+      return lane_summation::sum<T>(n, term);
+    } else {
+      T acc[lanes] = {}, comp[lanes] = {};
+
+      auto add = [&acc, &comp](std::size_t l, T val) {
+        T next = acc[l] + val;
+        comp[l] += (kernels::magnitude(acc[l]) >= kernels::magnitude(val) ? (acc[l] - next) + val : (val - next) + acc[l]);
+        acc[l] = next;
+      };
+
+      std::size_t i = 0;
+      for (; i + lanes <= n; i += lanes) {
+        for (std::size_t l = 0; l < lanes; ++l) {
+          add(l, term(i + l));
+        }
+      }
+      for (std::size_t l = 0; l < n - i; ++l) {
+        add(l, term(i + l));
+      }
+
+      T res{}, res_comp{};
+      for (std::size_t l = 0; l < lanes; ++l) {
+        for (T val : {acc[l], comp[l]}) {
+          T next = res + val;
+          res_comp += (kernels::magnitude(res) >= kernels::magnitude(val) ? (res - next) + val : (val - next) + res);
+          res = next;
+        }
+      }
+      return res + res_comp;
+    }
+  }
+
+  template <typename T> static constexpr T dot(const T *a, const T *b, std::size_t n) {
+    return sum<T>(n, [a, b](std::size_t i) { return a[i] * b[i]; });
+  }
+};
+
+template <typename P>
+concept summation_policy = requires(const double *ptr, std::size_t n) {
+  { P::template dot<double>(ptr, ptr, n) } -> std::same_as<double>;
+};
+
+// What operator* uses: as accurate as the sequential loop or better, and vectorizable.
+using default_summation = lane_summation;
+
+} // namespace linmath
+} // namespace throttle
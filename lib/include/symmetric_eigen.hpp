@@ -0,0 +1,364 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "contiguous_matrix.hpp"
+#include "thread_pool.hpp"
+#include "tile_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace throttle {
+namespace linmath {
+
+// Eigenvalues, and optionally eigenvectors, of a real symmetric matrix. Only the lower triangle is read.
+//
+// The matrix is first reduced to tridiagonal form T = Q^T * A * Q by n - 2 Householder reflectors, in panels of
+// columns so that most of the update of the trailing submatrix is a GEMM rather than one rank-2 update per reflector.
+// The products with the trailing submatrix and the updates are split by rows between the pool threads.
+// T is then diagonalized by implicit QL with Wilkinson shifts. One QL sweep is a chain of plane rotations; they are
+// recorded and applied to the rows of Q afterwards, each row on its own, so the eigenvectors come out of Q without a
+// separate back-transformation and the O(n^3) part runs in parallel.
+template <std::floating_point T> class symmetric_eigensolver {
+  using size_type = std::size_t;
+
+  struct rotation {
+    size_type i; // Acts on columns i and i + 1
+    T         c, s;
+  };
+
+  std::vector<T>       m_values;
+  contiguous_matrix<T> m_vectors;
+  bool                 m_has_vectors;
+
+  // Columns per panel of the blocked reduction. Trailing matrices up to twice that size are reduced column by column.
+  static constexpr size_type panel_width = 32, unblocked_size = 2 * panel_width;
+
+  // Reflector H_k that zeroes column k past the subdiagonal. Leaves the new subdiagonal entry in e[k] and v in column k
+  // below the diagonal, with v_k+1 = 1. Returns tau, which is zero if the column is zero already.
+  static T make_reflector(T *a, size_type n, size_type k, std::vector<T> &e) {
+    T alpha = a[(k + 1) * n + k], sigma = 0;
+    for (size_type r = k + 2; r < n; ++r) {
+      sigma += a[r * n + k] * a[r * n + k];
+    }
+
+    if (sigma == T{}) {
+      e[k] = alpha;
+      return T{};
+    }
+
+    T beta = -std::copysign(std::sqrt(alpha * alpha + sigma), alpha), scale = T{1} / (alpha - beta);
+    e[k] = beta;
+    a[(k + 1) * n + k] = T{1};
+    for (size_type r = k + 2; r < n; ++r) {
+      a[r * n + k] *= scale;
+    }
+    return (beta - alpha) / beta;
+  }
+
+  // p = tau * A22 * v for the reflector in column k, where A22 is the trailing submatrix past k.
+  static void trailing_product(const T *a, size_type n, size_type k, T t, std::vector<T> &p) {
+    const size_type first_row = k + 1;
+    concurrency::parallel_for(first_row, n, concurrency::grain_for(n - first_row),
+                              [a, n, k, first_row, t, &p](size_type first, size_type last) {
+                                for (size_type r = first; r < last; ++r) {
+                                  T sum = 0;
+                                  for (size_type c = first_row; c < n; ++c) {
+                                    sum += a[r * n + c] * a[c * n + k];
+                                  }
+                                  p[r] = t * sum;
+                                }
+                              });
+  }
+
+  // w = p - tau / 2 * (p^T * v) * v, stored back into p. Then A22 - v * w^T - w * v^T = H_k * A22 * H_k.
+  static void finish_w(const T *a, size_type n, size_type k, T t, std::vector<T> &p) {
+    T pv = 0;
+    for (size_type r = k + 1; r < n; ++r) {
+      pv += p[r] * a[r * n + k];
+    }
+    for (size_type r = k + 1; r < n; ++r) {
+      p[r] -= t / 2 * pv * a[r * n + k];
+    }
+  }
+
+  static void reduce_column(T *a, size_type n, size_type k, std::vector<T> &e, std::vector<T> &tau,
+                            std::vector<T> &p) {
+    tau[k] = make_reflector(a, n, k, e);
+    if (tau[k] == T{}) return;
+    trailing_product(a, n, k, tau[k], p);
+    finish_w(a, n, k, tau[k], p);
+
+    // A22 -= v * w^T + w * v^T, both triangles so that rows stay contiguous for the next product.
+    const size_type first_row = k + 1;
+    concurrency::parallel_for(first_row, n, concurrency::grain_for(n - first_row),
+                              [a, n, k, first_row, &p](size_type first, size_type last) {
+                                for (size_type r = first; r < last; ++r) {
+                                  T v_r = a[r * n + k], w_r = p[r];
+                                  for (size_type c = first_row; c < n; ++c) {
+                                    a[r * n + c] -= v_r * p[c] + w_r * a[c * n + k];
+                                  }
+                                }
+                              });
+  }
+
+  // Reduces columns [k0, k0 + panel_width) as in LAPACK's latrd. Each column is brought up to date and multiplied
+  // against the trailing matrix as it was before the panel, with the updates of the earlier panel columns applied on
+  // the fly from the v's and w's. The trailing matrix past the panel then takes all of them at once,
+  // A22 -= [V W] * [W V]^T, which is a GEMM of inner dimension 2 * panel_width instead of panel_width rank-2 updates.
+  // Rows of [V W] and [W V] are kept in vw and wv, n x 2 * panel_width each.
+  static void reduce_panel(T *a, size_type n, size_type k0, std::vector<T> &e, std::vector<T> &tau, std::vector<T> &p,
+                           std::vector<T> &vw, std::vector<T> &wv) {
+    constexpr size_type nb = panel_width, ld = 2 * nb;
+    auto                v = [a, n, k0](size_type r, size_type i) { return a[r * n + k0 + i]; };
+    auto                w = [&vw](size_type r, size_type i) { return vw[r * ld + nb + i]; };
+    std::vector<T>      wtv(nb), vtv(nb);
+
+    for (size_type i = 0; i < nb; ++i) {
+      const size_type j = k0 + i;
+      for (size_type r = j; r < n; ++r) {
+        T sum = 0;
+        for (size_type q = 0; q < i; ++q) {
+          sum += v(r, q) * w(j, q) + w(r, q) * v(j, q);
+        }
+        a[r * n + j] -= sum;
+      }
+
+      tau[j] = make_reflector(a, n, j, e);
+      if (tau[j] == T{}) {
+        for (size_type r = j + 1; r < n; ++r) {
+          vw[r * ld + nb + i] = T{};
+        }
+        continue;
+      }
+
+      // p = tau * (A22 - V * W^T - W * V^T) * v over the earlier panel columns.
+      trailing_product(a, n, j, tau[j], p);
+      std::fill(wtv.begin(), wtv.begin() + i, T{});
+      std::fill(vtv.begin(), vtv.begin() + i, T{});
+      for (size_type r = j + 1; r < n; ++r) {
+        for (size_type q = 0; q < i; ++q) {
+          wtv[q] += w(r, q) * a[r * n + j];
+          vtv[q] += v(r, q) * a[r * n + j];
+        }
+      }
+      for (size_type r = j + 1; r < n; ++r) {
+        T sum = 0;
+        for (size_type q = 0; q < i; ++q) {
+          sum += v(r, q) * wtv[q] + w(r, q) * vtv[q];
+        }
+        p[r] -= tau[j] * sum;
+      }
+
+      finish_w(a, n, j, tau[j], p);
+      for (size_type r = j + 1; r < n; ++r) {
+        vw[r * ld + nb + i] = p[r];
+      }
+    }
+
+    const size_type first_row = k0 + nb;
+    for (size_type r = first_row; r < n; ++r) {
+      for (size_type q = 0; q < nb; ++q) {
+        vw[r * ld + q] = wv[r * ld + nb + q] = v(r, q);
+        wv[r * ld + q] = w(r, q);
+      }
+    }
+
+    concurrency::parallel_for(first_row, n, concurrency::grain_for(ld * (n - first_row)),
+                              [a, n, first_row, &vw, &wv](size_type first, size_type last) {
+                                kernels::gemm_tile_sub_nt(a + first * n + first_row, vw.data() + first * ld,
+                                                          wv.data() + first_row * ld, last - first, n - first_row, ld,
+                                                          n, ld, ld);
+                              });
+  }
+
+  // Householder tridiagonalization in place. Leaves the diagonal in d, the subdiagonal in e[0, n - 1), and reflector
+  // k in column k below the subdiagonal with its scalar in tau[k].
+  static void tridiagonalize(contiguous_matrix<T> &mat, std::vector<T> &d, std::vector<T> &e, std::vector<T> &tau) {
+    const size_type n = mat.rows();
+    T              *a = mat.data();
+    std::vector<T>  p(n);
+
+    size_type k = 0;
+    if (n > unblocked_size) {
+      std::vector<T> vw(n * 2 * panel_width), wv(n * 2 * panel_width);
+      for (; n - k > unblocked_size; k += panel_width) {
+        reduce_panel(a, n, k, e, tau, p, vw, wv);
+      }
+    }
+    for (; k + 2 < n; ++k) {
+      reduce_column(a, n, k, e, tau, p);
+    }
+
+    for (size_type i = 0; i < n; ++i) {
+      d[i] = a[i * n + i];
+    }
+    if (n >= 2) e[n - 2] = a[(n - 1) * n + n - 2];
+  }
+
+  // Q = H_0 * ... * H_n-3, accumulated backwards into the identity. H_k only touches rows and columns past k.
+  static contiguous_matrix<T> accumulate_q(const contiguous_matrix<T> &mat, const std::vector<T> &tau) {
+    const size_type      n = mat.rows();
+    const T             *a = mat.data();
+    contiguous_matrix<T> q = contiguous_matrix<T>::unity(n);
+    T                   *z = q.data();
+
+    for (size_type k = n < 2 ? 0 : n - 2; k-- > 0;) {
+      if (tau[k] == T{}) continue;
+      const size_type first_row = k + 1;
+      auto            v = [a, n, k](size_type r) { return a[r * n + k]; };
+      concurrency::parallel_for(first_row, n, concurrency::grain_for(2 * (n - first_row)),
+                                [z, n, first_row, t = tau[k], &v](size_type first, size_type last) {
+                                  std::vector<T> w(last - first);
+                                  for (size_type r = first_row; r < n; ++r) {
+                                    for (size_type c = first; c < last; ++c) {
+                                      w[c - first] += v(r) * z[r * n + c];
+                                    }
+                                  }
+                                  for (size_type r = first_row; r < n; ++r) {
+                                    T tv = t * v(r);
+                                    for (size_type c = first; c < last; ++c) {
+                                      z[r * n + c] -= tv * w[c - first];
+                                    }
+                                  }
+                                });
+    }
+
+    return q;
+  }
+
+  void apply_rotations(const std::vector<rotation> &rotations) {
+    if (!m_has_vectors || rotations.empty()) return;
+    const size_type n = m_vectors.rows();
+    T              *z = m_vectors.data();
+    concurrency::parallel_for(0, n, concurrency::grain_for(4 * rotations.size()),
+                              [z, n, &rotations](size_type first, size_type last) {
+                                for (size_type r = first; r < last; ++r) {
+                                  T *row = z + r * n;
+                                  for (const auto &[i, c, s] : rotations) {
+                                    T f = row[i + 1];
+                                    row[i + 1] = s * row[i] + c * f;
+                                    row[i] = c * row[i] - s * f;
+                                  }
+                                }
+                              });
+  }
+
+  // Implicit QL with Wilkinson shifts on the tridiagonal (d, e), as in tqli from Numerical Recipes.
+  void diagonalize(std::vector<T> &d, std::vector<T> &e) {
+    const size_type       n = d.size();
+    const size_type       max_sweeps = 30 * std::max<size_type>(n, 1);
+    std::vector<rotation> rotations;
+
+    for (size_type l = 0; l < n; ++l) {
+      for (size_type sweeps = 0;; ++sweeps) {
+        size_type m = l;
+        for (; m + 1 < n; ++m) {
+          T dd = std::abs(d[m]) + std::abs(d[m + 1]);
+          if (std::abs(e[m]) <= std::numeric_limits<T>::epsilon() * dd) break;
+        }
+        if (m == l) break;
+        if (sweeps == max_sweeps) throw std::runtime_error("Eigenvalue iteration did not converge");
+
+        T g = (d[l + 1] - d[l]) / (2 * e[l]), r = std::hypot(g, T{1});
+        g = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+        T    s = 1, c = 1, p = 0;
+        bool underflow = false;
+
+        rotations.clear();
+        for (size_type i = m; i-- > l;) {
+          T f = s * e[i], b = c * e[i];
+          e[i + 1] = r = std::hypot(f, g);
+          if (r == T{}) {
+            d[i + 1] -= p;
+            e[m] = T{};
+            underflow = true;
+            break;
+          }
+          s = f / r;
+          c = g / r;
+          g = d[i + 1] - p;
+          r = (d[i] - g) * s + 2 * c * b;
+          d[i + 1] = g + (p = s * r);
+          g = c * r - b;
+          rotations.push_back({i, c, s});
+        }
+        apply_rotations(rotations);
+
+        if (underflow) continue;
+        d[l] -= p;
+        e[l] = g;
+        e[m] = T{};
+      }
+    }
+  }
+
+public:
+  symmetric_eigensolver(contiguous_matrix<T> mat, bool compute_vectors = true)
+      : m_values(mat.rows()), m_vectors{0, 0}, m_has_vectors{compute_vectors} {
+    if (!mat.square()) throw std::runtime_error("Mismatched matrix size for eigenvalues");
+
+    const size_type n = mat.rows();
+    for (size_type i = 0; i < n; ++i) {
+      for (size_type j = i + 1; j < n; ++j) {
+        mat.data()[i * n + j] = mat.data()[j * n + i];
+      }
+    }
+
+    std::vector<T> e(n), tau(n);
+    tridiagonalize(mat, m_values, e, tau);
+    if (m_has_vectors) m_vectors = accumulate_q(mat, tau);
+    diagonalize(m_values, e);
+
+    std::vector<size_type> order(n);
+    std::iota(order.begin(), order.end(), size_type{0});
+    std::sort(order.begin(), order.end(), [this](size_type x, size_type y) { return m_values[x] < m_values[y]; });
+
+    std::vector<T> values(n);
+    for (size_type j = 0; j < n; ++j) {
+      values[j] = m_values[order[j]];
+    }
+    m_values = std::move(values);
+
+    if (m_has_vectors) {
+      contiguous_matrix<T> sorted{n, n};
+      for (size_type i = 0; i < n; ++i) {
+        for (size_type j = 0; j < n; ++j) {
+          sorted.data()[i * n + j] = m_vectors.data()[i * n + order[j]];
+        }
+      }
+      m_vectors = std::move(sorted);
+    }
+  }
+
+  // In ascending order.
+  const std::vector<T> &eigenvalues() const { return m_values; }
+
+  // Orthonormal eigenvectors as columns, in the order of eigenvalues().
+  const contiguous_matrix<T> &eigenvectors() const {
+    if (!m_has_vectors) throw std::runtime_error("Eigenvectors were not computed");
+    return m_vectors;
+  }
+};
+
+template <std::floating_point T, matrix_layout L> std::vector<T> eigenvalues(const contiguous_matrix<T, L> &mat) {
+  return symmetric_eigensolver<T>{mat.template relayout<row_major>(), false}.eigenvalues();
+}
+
+} // namespace linmath
+} // namespace throttle
@@ -0,0 +1,127 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace throttle {
+namespace concurrency {
+
+// Dependency driven task runtime. Every task keeps a counter of unfinished predecessors; a task is handed to the pool
+// as soon as its counter drops to zero, so independent work from different algorithm steps overlaps instead of
+// meeting at a barrier after every step. The graph can be run several times.
+class task_graph {
+public:
+  using task_id = std::size_t;
+
+private:
+  struct node {
+    std::function<void()>    work;
+    std::vector<task_id>     successors;
+    std::size_t              dependencies = 0;
+    std::atomic<std::size_t> pending = 0;
+
+    node(std::function<void()> &&func) : work{std::move(func)} {}
+  };
+
+  std::deque<node>         m_nodes; // Atomics are not movable, deque keeps nodes in place.
+  std::atomic<std::size_t> m_remaining = 0;
+  std::atomic<bool>        m_failed = false;
+  std::exception_ptr       m_exception;
+  std::mutex               m_exception_mutex;
+
+  void execute(task_id id, thread_pool &pool) {
+    while (true) {
+      node &current = m_nodes[id];
+
+      if (!m_failed.load(std::memory_order_relaxed)) {
+        try {
+          current.work();
+        } catch (...) {
+          std::lock_guard lock{m_exception_mutex};
+          if (!m_exception) m_exception = std::current_exception();
+          m_failed.store(true, std::memory_order_relaxed);
+        }
+      }
+
+      // Keep one ready successor for this thread and hand the rest to the pool.
+      bool    has_next = false;
+      task_id next = 0;
+      for (auto succ : current.successors) {
+        if (m_nodes[succ].pending.fetch_sub(1, std::memory_order_acq_rel) != 1) continue;
+        if (!has_next) {
+          has_next = true;
+          next = succ;
+        } else {
+          pool.submit([this, succ, &pool] { execute(succ, pool); });
+        }
+      }
+
+      // Last touch of the graph by this thread for the finished task; run() may return right after.
+      if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) pool.notify();
+      if (!has_next) return;
+      id = next;
+    }
+  }
+
+public:
+  task_graph() = default;
+  task_graph(const task_graph &) = delete;
+  task_graph &operator=(const task_graph &) = delete;
+
+  task_id add(std::function<void()> work) {
+    m_nodes.emplace_back(std::move(work));
+    return m_nodes.size() - 1;
+  }
+
+  // `after` may only start once `before` has finished.
+  void precede(task_id before, task_id after) {
+    if (before >= m_nodes.size() || after >= m_nodes.size()) throw std::out_of_range("Unknown task id");
+    m_nodes[before].successors.push_back(after);
+    ++m_nodes[after].dependencies;
+  }
+
+  std::size_t size() const { return m_nodes.size(); }
+
+  // Execute all tasks and wait for them, helping the pool meanwhile. The first exception thrown by a task is
+  // rethrown here; tasks that were not started by then are skipped.
+  void run(thread_pool &pool = thread_pool::instance()) {
+    if (m_nodes.empty()) return;
+
+    m_failed = false;
+    m_exception = nullptr;
+    m_remaining = m_nodes.size();
+    for (auto &n : m_nodes) {
+      n.pending = n.dependencies;
+    }
+
+    for (task_id id = 0; id < m_nodes.size(); ++id) {
+      if (m_nodes[id].dependencies) continue;
+      pool.submit([this, id, &pool] { execute(id, pool); });
+    }
+
+    pool.wait_until([this] { return m_remaining.load(std::memory_order_acquire) == 0; });
+    if (m_exception) std::rethrow_exception(m_exception);
+  }
+};
+
+} // namespace concurrency
+} // namespace throttle
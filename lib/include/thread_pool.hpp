@@ -0,0 +1,434 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace throttle {
+namespace concurrency {
+
+// Chase-Lev work stealing deque (as formulated for C11 atomics by Le, Pop, Cohen and Zappa Nardelli). The owner pushes
+// and pops at the bottom, other threads steal from the top. T has to be trivially copyable; the pool stores pointers.
+template <typename T> class work_stealing_deque {
+  struct ring {
+    std::int64_t                    m_capacity;
+    std::unique_ptr<std::atomic<T>[]> m_buffer;
+
+    ring(std::int64_t capacity) : m_capacity{capacity}, m_buffer{new std::atomic<T>[capacity]} {}
+
+    T    get(std::int64_t idx) const { return m_buffer[idx & (m_capacity - 1)].load(std::memory_order_relaxed); }
+    void put(std::int64_t idx, T val) { m_buffer[idx & (m_capacity - 1)].store(val, std::memory_order_relaxed); }
+  };
+
+  std::atomic<std::int64_t>         m_top = 0, m_bottom = 0;
+  std::atomic<ring *>               m_ring;
+  std::vector<std::unique_ptr<ring>> m_rings; // Thieves may still read a retired ring, so all of them live until the end.
+
+  ring *grow(ring *old, std::int64_t bottom, std::int64_t top) {
+    auto bigger = std::make_unique<ring>(old->m_capacity * 2);
+    for (std::int64_t i = top; i < bottom; ++i) {
+      bigger->put(i, old->get(i));
+    }
+    ring *res = bigger.get();
+    m_rings.push_back(std::move(bigger));
+    m_ring.store(res, std::memory_order_release);
+    return res;
+  }
+
+public:
+  explicit work_stealing_deque(std::int64_t capacity = 256) {
+    m_rings.push_back(std::make_unique<ring>(capacity));
+    m_ring.store(m_rings.back().get(), std::memory_order_relaxed);
+  }
+
+  work_stealing_deque(const work_stealing_deque &) = delete;
+  work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+
+  // Owner only.
+  void push(T val) {
+    std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    std::int64_t top = m_top.load(std::memory_order_acquire);
+    ring        *current = m_ring.load(std::memory_order_relaxed);
+
+    if (bottom - top > current->m_capacity - 1) current = grow(current, bottom, top);
+    current->put(bottom, val);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  // Owner only.
+  std::optional<T> pop() {
+    std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    ring        *current = m_ring.load(std::memory_order_relaxed);
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = m_top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      m_bottom.store(bottom + 1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+
+    T val = current->get(bottom);
+    if (top == bottom) {
+      // Last element, race against thieves.
+      bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      m_bottom.store(bottom + 1, std::memory_order_relaxed);
+      if (!won) return std::nullopt;
+    }
+    return val;
+  }
+
+  // Any thread. Fails spuriously when another thief or the owner wins the race for the same element.
+  std::optional<T> steal() {
+    std::int64_t top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t bottom = m_bottom.load(std::memory_order_acquire);
+    if (top >= bottom) return std::nullopt;
+
+    T val = m_ring.load(std::memory_order_acquire)->get(top);
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return std::nullopt;
+    }
+    return val;
+  }
+
+  bool empty() const {
+    return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+  }
+};
+
+struct thread_pool_config {
+  std::size_t threads = 0;     // 0 means std::thread::hardware_concurrency()
+  bool        pin_threads = false; // Bind worker i to cpu i (Linux only)
+
+  // THROTTLE_NUM_THREADS sets the number of workers, THROTTLE_PIN_THREADS=1 enables pinning.
+  static thread_pool_config from_env() {
+    thread_pool_config config;
+    if (const char *threads = std::getenv("THROTTLE_NUM_THREADS")) {
+      config.threads = std::strtoul(threads, nullptr, 10);
+    }
+    if (const char *pin = std::getenv("THROTTLE_PIN_THREADS")) {
+      config.pin_threads = (std::strtol(pin, nullptr, 10) != 0);
+    }
+    return config;
+  }
+};
+
+// Persistent work stealing pool. Every worker owns a Chase-Lev deque; tasks submitted from a worker go to its own deque
+// and tasks from outside go to a shared injection queue. Idle workers steal, and park on a futex-backed atomic wait
+// when there is nothing left. Threads blocked waiting for pool work (see wait_until) execute tasks themselves, so
+// nested parallel regions cannot starve the pool.
+class thread_pool {
+public:
+  using task_type = std::function<void()>;
+
+private:
+  static constexpr std::size_t not_a_worker = std::size_t(-1);
+
+  struct worker {
+    work_stealing_deque<task_type *> m_deque;
+    std::thread                      m_thread;
+  };
+
+  struct thread_context {
+    thread_pool  *m_pool = nullptr;
+    std::size_t   m_index = not_a_worker;
+    std::uint32_t m_seed = 0x9e3779b9u;
+  };
+
+  std::vector<std::unique_ptr<worker>> m_workers;
+  std::deque<task_type *>              m_injection;
+  std::mutex                           m_injection_mutex;
+  std::atomic<std::size_t>             m_injection_size = 0;
+  std::atomic<std::uint32_t>           m_epoch = 0;
+  std::atomic<std::uint32_t>           m_sleepers = 0;
+  std::atomic<bool>                    m_stop = false;
+
+  static thread_context &context() {
+    thread_local thread_context ctx;
+    return ctx;
+  }
+
+  std::size_t current_index() const {
+    auto &ctx = context();
+    return (ctx.m_pool == this ? ctx.m_index : not_a_worker);
+  }
+
+  task_type *pop_injected() {
+    if (!m_injection_size.load(std::memory_order_acquire)) return nullptr;
+    std::lock_guard lock{m_injection_mutex};
+    if (m_injection.empty()) return nullptr;
+    task_type *task = m_injection.front();
+    m_injection.pop_front();
+    m_injection_size.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+  }
+
+  task_type *find_task(std::size_t self) {
+    if (self != not_a_worker) {
+      if (auto task = m_workers[self]->m_deque.pop()) return *task;
+    }
+
+    if (auto task = pop_injected()) return task;
+
+    // Visit victims starting from a random one so that thieves do not all hammer worker 0.
+    auto &seed = context().m_seed;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    const std::size_t count = m_workers.size();
+    for (std::size_t i = 0, start = seed % count; i < count; ++i) {
+      std::size_t victim = (start + i) % count;
+      if (victim == self) continue;
+      if (auto task = m_workers[victim]->m_deque.steal()) return *task;
+    }
+
+    return nullptr;
+  }
+
+  static void run_task(task_type *task) {
+    std::unique_ptr<task_type> owner{task};
+    (*owner)();
+  }
+
+  void wake_one() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!m_sleepers.load(std::memory_order_relaxed)) return;
+    m_epoch.fetch_add(1, std::memory_order_release);
+    m_epoch.notify_one();
+  }
+
+  // Sleep until the epoch moves, unless work shows up or stop() returns true in the meantime. Returns a task found
+  // during the last check, if any.
+  template <typename F> task_type *park(std::size_t self, F stop) {
+    std::uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+    m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    task_type *task = find_task(self);
+    if (!task && !stop()) m_epoch.wait(epoch, std::memory_order_acquire);
+
+    m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+  }
+
+  void pin_to_cpu([[maybe_unused]] std::size_t index) {
+#ifdef __linux__
+    unsigned  cpus = std::max(1u, std::thread::hardware_concurrency());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(index % cpus, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+  }
+
+  void worker_loop(std::size_t index, bool pin) {
+    context() = thread_context{this, index, static_cast<std::uint32_t>(index * 2654435761u + 1)};
+    if (pin) pin_to_cpu(index);
+
+    for (;;) {
+      task_type *task = find_task(index);
+      if (!task) task = park(index, [this] { return m_stop.load(std::memory_order_acquire); });
+      if (task) {
+        run_task(task);
+        continue;
+      }
+      if (m_stop.load(std::memory_order_acquire)) return;
+    }
+  }
+
+  static std::optional<thread_pool_config> &default_config() {
+    static std::optional<thread_pool_config> config;
+    return config;
+  }
+
+  static std::atomic<bool> &instance_created() {
+    static std::atomic<bool> created = false;
+    return created;
+  }
+
+public:
+  explicit thread_pool(thread_pool_config config = thread_pool_config::from_env()) {
+    std::size_t threads = (config.threads ? config.threads : std::max(1u, std::thread::hardware_concurrency()));
+    m_workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+      m_workers.push_back(std::make_unique<worker>());
+    }
+    for (std::size_t i = 0; i < threads; ++i) {
+      m_workers[i]->m_thread = std::thread{[this, i, pin = config.pin_threads] { worker_loop(i, pin); }};
+    }
+  }
+
+  explicit thread_pool(std::size_t threads) : thread_pool{thread_pool_config{threads}} {}
+
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  // Tasks that nobody picked up by now are dropped.
+  ~thread_pool() {
+    m_stop.store(true, std::memory_order_release);
+    m_epoch.fetch_add(1, std::memory_order_release);
+    m_epoch.notify_all();
+
+    for (auto &w : m_workers) {
+      w->m_thread.join();
+    }
+
+    for (auto &w : m_workers) {
+      while (auto task = w->m_deque.pop()) {
+        delete *task;
+      }
+    }
+    for (auto *task : m_injection) {
+      delete task;
+    }
+  }
+
+  std::size_t size() const { return m_workers.size(); }
+
+  // Tasks must not throw.
+  void submit(task_type task) {
+    auto       *ptr = new task_type{std::move(task)};
+    std::size_t self = current_index();
+
+    if (self != not_a_worker) {
+      m_workers[self]->m_deque.push(ptr);
+    } else {
+      std::lock_guard lock{m_injection_mutex};
+      m_injection.push_back(ptr);
+      m_injection_size.fetch_add(1, std::memory_order_release);
+    }
+
+    wake_one();
+  }
+
+  // Run one pending task on the calling thread. Returns false if there was nothing to do.
+  bool try_run_one() {
+    task_type *task = find_task(current_index());
+    if (!task) return false;
+    run_task(task);
+    return true;
+  }
+
+  // Help with pending work until done() becomes true. Whoever makes done() true has to call notify() afterwards.
+  template <typename F> void wait_until(F done) {
+    std::size_t self = current_index();
+    while (!done()) {
+      task_type *task = find_task(self);
+      if (!task) task = park(self, done);
+      if (task) run_task(task);
+    }
+  }
+
+  // Wake up every thread parked in the pool, including those in wait_until.
+  void notify() {
+    m_epoch.fetch_add(1, std::memory_order_release);
+    m_epoch.notify_all();
+  }
+
+  // Configure the pool returned by instance(). Has to happen before its first use; returns false otherwise.
+  static bool configure(thread_pool_config config) {
+    if (instance_created().load()) return false;
+    default_config() = config;
+    return true;
+  }
+
+  static thread_pool &instance() {
+    static thread_pool pool{[] {
+      instance_created() = true;
+      return default_config().value_or(thread_pool_config::from_env());
+    }()};
+    return pool;
+  }
+};
+
+// Chunk size that gives each task at least `min_work` units of work when one item costs `work_per_item`.
+inline std::size_t grain_for(std::size_t work_per_item, std::size_t min_work = std::size_t{1} << 15) {
+  return std::max<std::size_t>(1, min_work / std::max<std::size_t>(1, work_per_item));
+}
+
+// Call func(chunk_first, chunk_last) over [first, last) split into chunks of at least `grain` indices. Ranges no longer
+// than one grain run inline on the calling thread, which also takes part in the loop. The first exception thrown by
+// func is rethrown after all chunks have finished.
+template <typename F>
+void parallel_for(std::size_t first, std::size_t last, std::size_t grain, F &&func,
+                  thread_pool &pool = thread_pool::instance()) {
+  if (first >= last) return;
+
+  const std::size_t count = last - first;
+  grain = std::max<std::size_t>(grain, 1);
+  if (count <= grain) {
+    func(first, last);
+    return;
+  }
+
+  // A few chunks per thread so that uneven chunks even out.
+  const std::size_t max_chunks = (pool.size() + 1) * 4;
+  const std::size_t chunk = std::max(grain, (count + max_chunks - 1) / max_chunks);
+  const std::size_t chunks = (count + chunk - 1) / chunk;
+
+  struct loop_state {
+    std::atomic<std::size_t> next = 0, finished = 0;
+    std::exception_ptr       error;
+    std::mutex               error_mutex;
+  };
+
+  // Helpers may get to run after the loop is over; they only touch the shared state then.
+  auto state = std::make_shared<loop_state>();
+  auto body = [state, &func, &pool, first, last, chunk, chunks] {
+    for (;;) {
+      std::size_t idx = state->next.fetch_add(1, std::memory_order_relaxed);
+      if (idx >= chunks) return;
+
+      std::size_t lo = first + idx * chunk, hi = std::min(last, lo + chunk);
+      try {
+        func(lo, hi);
+      } catch (...) {
+        std::lock_guard lock{state->error_mutex};
+        if (!state->error) state->error = std::current_exception();
+      }
+
+      if (state->finished.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) pool.notify();
+    }
+  };
+
+  for (std::size_t i = 0, helpers = std::min(chunks - 1, pool.size()); i < helpers; ++i) {
+    pool.submit(body);
+  }
+
+  body();
+  pool.wait_until([&state, chunks] { return state->finished.load(std::memory_order_acquire) == chunks; });
+
+  if (state->error) std::rethrow_exception(state->error);
+}
+
+} // namespace concurrency
+} // namespace throttle
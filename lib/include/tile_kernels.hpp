@@ -0,0 +1,156 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+namespace throttle {
+namespace linmath {
+namespace kernels {
+
+// Kernels on dense row-major blocks with leading dimension `ld`, as found inside a tiled matrix. Loops are ordered so
+// that the innermost one runs along a contiguous row of the output.
+
+// dst = transpose(src) for a full ld x ld tile.
+template <typename T> void transpose_tile(T *dst, const T *src, std::size_t ld) {
+  for (std::size_t i = 0; i < ld; ++i) {
+    for (std::size_t j = 0; j < ld; ++j) {
+      dst[j * ld + i] = src[i * ld + j];
+    }
+  }
+}
+
+// c[m x n] += a[m x k] * b[k x n]
+template <typename T>
+void gemm_tile_add(T *c, const T *a, const T *b, std::size_t m, std::size_t n, std::size_t k, std::size_t ld) {
+  for (std::size_t i = 0; i < m; ++i) {
+    for (std::size_t p = 0; p < k; ++p) {
+      const T  a_ip = a[i * ld + p];
+      const T *b_row = b + p * ld;
+      T       *c_row = c + i * ld;
+      for (std::size_t j = 0; j < n; ++j) {
+        c_row[j] = c_row[j] + a_ip * b_row[j];
+      }
+    }
+  }
+}
+
+// c[m x n] -= a[m x k] * b[k x n]
+template <typename T>
+void gemm_tile_sub(T *c, const T *a, const T *b, std::size_t m, std::size_t n, std::size_t k, std::size_t ld) {
+  for (std::size_t i = 0; i < m; ++i) {
+    for (std::size_t p = 0; p < k; ++p) {
+      const T  a_ip = a[i * ld + p];
+      const T *b_row = b + p * ld;
+      T       *c_row = c + i * ld;
+      for (std::size_t j = 0; j < n; ++j) {
+        c_row[j] = c_row[j] - a_ip * b_row[j];
+      }
+    }
+  }
+}
+
+// Solve L * X = B in place of b[m x n], where L is the unit lower triangle of l[m x m].
+template <typename T> void trsm_unit_lower_tile(const T *l, T *b, std::size_t m, std::size_t n, std::size_t ld) {
+  for (std::size_t i = 1; i < m; ++i) {
+    T *b_row = b + i * ld;
+    for (std::size_t p = 0; p < i; ++p) {
+      const T  l_ip = l[i * ld + p];
+      const T *b_src = b + p * ld;
+      for (std::size_t j = 0; j < n; ++j) {
+        b_row[j] = b_row[j] - l_ip * b_src[j];
+      }
+    }
+  }
+}
+
+// c[m x n] -= a[m x k] * transpose(b[n x k]), each block with its own leading dimension.
+template <typename T>
+void gemm_tile_sub_nt(T *c, const T *a, const T *b, std::size_t m, std::size_t n, std::size_t k, std::size_t ldc,
+                      std::size_t lda, std::size_t ldb) {
+  for (std::size_t i = 0; i < m; ++i) {
+    const T *a_row = a + i * lda;
+    for (std::size_t j = 0; j < n; ++j) {
+      const T *b_row = b + j * ldb;
+      T        sum = T{};
+      for (std::size_t p = 0; p < k; ++p) {
+        sum = sum + a_row[p] * b_row[p];
+      }
+      c[i * ldc + j] = c[i * ldc + j] - sum;
+    }
+  }
+}
+
+// c[m x n] -= a[m x k] * transpose(b[n x k])
+template <typename T>
+void gemm_tile_sub_nt(T *c, const T *a, const T *b, std::size_t m, std::size_t n, std::size_t k, std::size_t ld) {
+  gemm_tile_sub_nt(c, a, b, m, n, k, ld, ld, ld);
+}
+
+// Lower triangle of c[n x n] -= a[n x k] * transpose(a). The strict upper triangle is not touched.
+template <typename T> void syrk_lower_tile(T *c, const T *a, std::size_t n, std::size_t k, std::size_t ld) {
+  for (std::size_t i = 0; i < n; ++i) {
+    const T *a_row = a + i * ld;
+    for (std::size_t j = 0; j <= i; ++j) {
+      const T *b_row = a + j * ld;
+      T        sum = T{};
+      for (std::size_t p = 0; p < k; ++p) {
+        sum = sum + a_row[p] * b_row[p];
+      }
+      c[i * ld + j] = c[i * ld + j] - sum;
+    }
+  }
+}
+
+// In place Cholesky factorization of the lower triangle of a[m x m]. Returns false if the block is not positive
+// definite. The strict upper triangle is not touched.
+template <typename T> bool potrf_lower_tile(T *a, std::size_t m, std::size_t ld) {
+  for (std::size_t j = 0; j < m; ++j) {
+    T *row_j = a + j * ld;
+    T  diag = row_j[j];
+    for (std::size_t p = 0; p < j; ++p) {
+      diag = diag - row_j[p] * row_j[p];
+    }
+    if (!(diag > T{})) return false;
+    diag = std::sqrt(diag);
+    row_j[j] = diag;
+
+    for (std::size_t i = j + 1; i < m; ++i) {
+      T *row_i = a + i * ld;
+      T  sum = row_i[j];
+      for (std::size_t p = 0; p < j; ++p) {
+        sum = sum - row_i[p] * row_j[p];
+      }
+      row_i[j] = sum / diag;
+    }
+  }
+  return true;
+}
+
+// Solve X * transpose(L) = B in place of b[m x n], where L is the lower triangle of l[n x n].
+template <typename T> void trsm_right_lower_trans_tile(const T *l, T *b, std::size_t m, std::size_t n, std::size_t ld) {
+  for (std::size_t i = 0; i < m; ++i) {
+    T *b_row = b + i * ld;
+    for (std::size_t j = 0; j < n; ++j) {
+      const T *l_row = l + j * ld;
+      T        sum = b_row[j];
+      for (std::size_t p = 0; p < j; ++p) {
+        sum = sum - b_row[p] * l_row[p];
+      }
+      b_row[j] = sum / l_row[j];
+    }
+  }
+}
+
+} // namespace kernels
+} // namespace linmath
+} // namespace throttle
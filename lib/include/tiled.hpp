@@ -0,0 +1,259 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "contiguous_matrix.hpp"
+#include "isa.hpp"
+#include "layout.hpp"
+#include "pivot.hpp"
+#include "task_graph.hpp"
+#include "thread_pool.hpp"
+#include "tile_kernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace throttle {
+namespace linmath {
+
+template <typename T, std::size_t Tile = 64> using tiled_matrix = contiguous_matrix<T, tiled<Tile>>;
+
+// Copy a matrix given by row pointers into tiled storage, one contiguous row segment per tile.
+template <typename T, std::size_t Tile = 64>
+tiled_matrix<T, Tile> tiled_from_rows(const T *const *rows, std::size_t n_rows, std::size_t n_cols) {
+  tiled_matrix<T, Tile> res{n_rows, n_cols};
+  for (std::size_t i = 0; i < n_rows; ++i) {
+    for (std::size_t tj = 0; tj < res.tile_cols(); ++tj) {
+      const T *first = rows[i] + tj * Tile;
+      std::copy(first, rows[i] + std::min((tj + 1) * Tile, n_cols), res.tile_data(i / Tile, tj) + (i % Tile) * Tile);
+    }
+  }
+  return res;
+}
+
+namespace detail {
+
+// Blocked right-looking LU with partial pivoting on a square tiled matrix, factorized in place. Step k factorizes tile
+// column k (the panel) and then updates every trailing tile column with whole-tile kernels. A panel only swaps rows
+// inside its own tile column and records the pivots; each trailing column applies them right before its own update.
+// That way a column update touches nothing but the tiles of its column and the panel, which is what lets the task
+// graph run panel k + 1 while updates of step k are still in flight.
+template <std::floating_point T, std::size_t Tile> class tiled_lu {
+  using size_type = std::size_t;
+
+  tiled_matrix<T, Tile> &m_mat;
+  size_type              m_size, m_tiles;
+  std::vector<size_type> m_pivots;
+
+  T &at(size_type row, size_type col) {
+    return m_mat.tile_data(row / Tile, col / Tile)[(row % Tile) * Tile + col % Tile];
+  }
+
+  // Swap two rows inside tile column tj.
+  void swap_rows(size_type row1, size_type row2, size_type tj) {
+    T *first = m_mat.tile_data(row1 / Tile, tj) + (row1 % Tile) * Tile;
+    T *second = m_mat.tile_data(row2 / Tile, tj) + (row2 % Tile) * Tile;
+    std::swap_ranges(first, first + Tile, second);
+  }
+
+public:
+  tiled_lu(tiled_matrix<T, Tile> &mat)
+      : m_mat{mat}, m_size{mat.rows()}, m_tiles{mat.tile_rows()}, m_pivots(mat.rows()) {}
+
+  size_type tiles() const { return m_tiles; }
+
+  // Factorize tile column k. Returns the sign of the row swaps or 0 for a zero pivot.
+  int factorize_panel(size_type k) {
+    int       sign = 1;
+    size_type first = k * Tile, last = std::min(first + Tile, m_size);
+
+    for (size_type c = first; c < last; ++c) {
+      size_type pivot_row = c + kernels::detail::argmax_abs_impl<T>(m_size - c, [this, c](size_type i) {
+                              return at(c + i, c);
+                            });
+
+      m_pivots[c] = pivot_row;
+      if (at(pivot_row, c) == T{}) return 0;
+      if (pivot_row != c) {
+        swap_rows(c, pivot_row, k);
+        sign = -sign;
+      }
+
+      T pivot = at(c, c);
+      for (size_type i = c + 1; i < m_size; ++i) {
+        T &l_ic = at(i, c);
+        l_ic /= pivot;
+        for (size_type j = c + 1; j < last; ++j) {
+          at(i, j) -= l_ic * at(c, j);
+        }
+      }
+    }
+
+    return sign;
+  }
+
+  // Update tile column j > k after panel k: apply the panel's row swaps, U_kj = L_kk^-1 A_kj, then A_ij -= L_ik U_kj for
+  // all i > k.
+  void update_column(size_type k, size_type j) {
+    for (size_type c = k * Tile; c < (k + 1) * Tile; ++c) {
+      if (m_pivots[c] != c) swap_rows(c, m_pivots[c], j);
+    }
+
+    kernels::trsm_unit_lower_tile(m_mat.tile_data(k, k), m_mat.tile_data(k, j), Tile, Tile, Tile);
+    for (size_type i = k + 1; i < m_tiles; ++i) {
+      kernels::gemm_tile_sub(m_mat.tile_data(i, j), m_mat.tile_data(i, k), m_mat.tile_data(k, j), Tile, Tile, Tile,
+                             Tile);
+    }
+  }
+
+  T diagonal_product() {
+    T res = 1;
+    for (size_type i = 0; i < m_size; ++i) {
+      res *= at(i, i);
+    }
+    return res;
+  }
+};
+
+} // namespace detail
+
+// Determinant through the tiled LU. Tasks are a panel factorization per step and one update per trailing tile column;
+// panel k + 1 depends only on the update of its own column, so it overlaps with the rest of step k.
+template <std::floating_point T, std::size_t Tile>
+T tiled_determinant(tiled_matrix<T, Tile> mat, concurrency::thread_pool &pool = concurrency::thread_pool::instance()) {
+  if (!mat.square()) throw std::runtime_error("Mismatched matrix size for determinant");
+
+  using task_id = concurrency::task_graph::task_id;
+
+  detail::tiled_lu<T, Tile> lu{mat};
+  const std::size_t         tiles = lu.tiles();
+  std::vector<int>          signs(tiles, 1);
+  std::atomic<bool>         singular = false;
+  concurrency::task_graph   graph;
+  std::vector<task_id>      last_writer(tiles);
+
+  for (std::size_t k = 0; k < tiles; ++k) {
+    task_id panel = graph.add([&lu, &signs, &singular, k] {
+      if (singular.load(std::memory_order_relaxed)) return;
+      signs[k] = isa::dispatch([&] { return lu.factorize_panel(k); });
+      if (!signs[k]) singular.store(true, std::memory_order_relaxed);
+    });
+    if (k) graph.precede(last_writer[k], panel);
+    last_writer[k] = panel;
+
+    for (std::size_t j = k + 1; j < tiles; ++j) {
+      task_id update = graph.add([&lu, &singular, k, j] {
+        if (singular.load(std::memory_order_relaxed)) return;
+        isa::dispatch([&] { lu.update_column(k, j); });
+      });
+      graph.precede(panel, update);
+      if (k) graph.precede(last_writer[j], update);
+      last_writer[j] = update;
+    }
+  }
+
+  graph.run(pool);
+  if (singular) return T{};
+
+  int sign = 1;
+  for (auto s : signs) {
+    sign *= s;
+  }
+
+  return sign * lu.diagonal_product();
+}
+
+// Floating point tiled matrices past the unrolled kernels take the tiled LU, except in constant evaluation.
+template <std::floating_point T, std::size_t Tile> constexpr T determinant(const tiled_matrix<T, Tile> &mat) {
+  if (std::is_constant_evaluated() || mat.rows() <= kernels::max_small_determinant) {
+    return detail::elimination_determinant(mat);
+  }
+  return tiled_determinant(mat);
+}
+
+// Tiled Cholesky factorization A = L * transpose(L) of a symmetric positive definite matrix, in place. Only the lower
+// triangle is referenced and it is overwritten with L. Returns false if the matrix is not positive definite. Every
+// tile operation is a separate task that waits for the last writers of the tiles it reads.
+template <std::floating_point T, std::size_t Tile>
+bool cholesky(tiled_matrix<T, Tile> &mat, concurrency::thread_pool &pool = concurrency::thread_pool::instance()) {
+  if (!mat.square()) throw std::runtime_error("Cholesky factorization of a non-square matrix");
+
+  using task_id = concurrency::task_graph::task_id;
+
+  const std::size_t       size = mat.rows(), tiles = mat.tile_rows();
+  std::atomic<bool>       failed = false;
+  concurrency::task_graph graph;
+
+  // Last task that wrote tile (i, j), i >= j. Tiles that nobody wrote yet have no entry.
+  std::vector<std::optional<task_id>> last_writer(tiles * tiles);
+  auto                                writer = [&last_writer, tiles](std::size_t i, std::size_t j) -> auto & {
+    return last_writer[i * tiles + j];
+  };
+  auto depends = [&graph](const std::optional<task_id> &before, task_id after) {
+    if (before) graph.precede(*before, after);
+  };
+
+  for (std::size_t k = 0; k < tiles; ++k) {
+    std::size_t diag_size = std::min(Tile, size - k * Tile);
+    task_id     potrf = graph.add([&mat, &failed, k, diag_size] {
+      if (failed.load(std::memory_order_relaxed)) return;
+      if (!isa::dispatch([&] { return kernels::potrf_lower_tile(mat.tile_data(k, k), diag_size, Tile); })) {
+        failed.store(true);
+      }
+    });
+    depends(writer(k, k), potrf);
+    writer(k, k) = potrf;
+
+    for (std::size_t i = k + 1; i < tiles; ++i) {
+      task_id trsm = graph.add([&mat, &failed, i, k] {
+        if (failed.load(std::memory_order_relaxed)) return;
+        isa::dispatch([&] {
+          kernels::trsm_right_lower_trans_tile(mat.tile_data(k, k), mat.tile_data(i, k), Tile, Tile, Tile);
+        });
+      });
+      graph.precede(potrf, trsm);
+      depends(writer(i, k), trsm);
+      writer(i, k) = trsm;
+    }
+
+    for (std::size_t i = k + 1; i < tiles; ++i) {
+      for (std::size_t j = k + 1; j <= i; ++j) {
+        task_id update = graph.add([&mat, &failed, i, j, k] {
+          if (failed.load(std::memory_order_relaxed)) return;
+          // Diagonal tiles only keep their lower triangle up to date, which is all that potrf reads.
+          isa::dispatch([&] {
+            if (i == j) {
+              kernels::syrk_lower_tile(mat.tile_data(i, i), mat.tile_data(i, k), Tile, Tile, Tile);
+            } else {
+              kernels::gemm_tile_sub_nt(mat.tile_data(i, j), mat.tile_data(i, k), mat.tile_data(j, k), Tile, Tile,
+                                        Tile, Tile);
+            }
+          });
+        });
+        depends(writer(i, k), update);
+        depends(writer(j, k), update);
+        depends(writer(i, j), update);
+        writer(i, j) = update;
+      }
+    }
+  }
+
+  graph.run(pool);
+  return !failed;
+}
+
+} // namespace linmath
+} // namespace throttle
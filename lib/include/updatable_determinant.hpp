@@ -0,0 +1,217 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "contiguous_matrix.hpp"
+#include "isa.hpp"
+#include "matrix.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace throttle {
+namespace linmath {
+
+// Determinant of a square matrix that changes by rank-1 updates, whole rows or whole columns. Keeps the matrix and
+// its inverse; an update A + u * v^T costs O(n^2) through the matrix determinant lemma
+//   det(A + u * v^T) = det(A) * (1 + v^T * A^-1 * u)
+// and Sherman-Morrison for the inverse. Rounding errors of the inverse accumulate, so it is recomputed from the
+// matrix every `refactor_period` updates, and right away after an update with a nearly vanishing denominator. While
+// the matrix is singular there is no inverse and every update refactorizes.
+template <std::floating_point T> class updatable_determinant {
+  using size_type = std::size_t;
+
+  contiguous_matrix<T> m_mat, m_inverse;
+  T                    m_det = T{};
+  bool                 m_singular = false;
+  size_type            m_updates = 0, m_refactor_period;
+
+  size_type size() const { return m_mat.rows(); }
+
+  void check_size(std::span<const T> vec) const {
+    if (vec.size() != size()) throw std::runtime_error("Mismatched vector size for update");
+  }
+
+  // Gauss-Jordan on [A | I] leaves D * A^-1 on the right, with D the diagonal left on the left side.
+  void refactorize_impl() {
+    const size_type n = size();
+    matrix<T>       aug{n, 2 * n};
+    for (size_type i = 0; i < n; ++i) {
+      std::copy_n(m_mat.data() + i * n, n, &aug[i][0]);
+      aug[i][n + i] = T{1};
+    }
+
+    m_updates = 0;
+    auto sign = aug.convert_to_row_echelon();
+    m_singular = !sign;
+    if (m_singular) {
+      m_det = T{};
+      return;
+    }
+
+    m_det = sign.value();
+    for (size_type i = 0; i < n; ++i) {
+      T diag = aug[i][i];
+      m_det *= diag;
+      for (size_type j = 0; j < n; ++j) {
+        m_inverse.data()[i * n + j] = aug[i][n + j] / diag;
+      }
+    }
+  }
+
+  // A^-1 -= x * y^T / denom, with x = A^-1 * u and y^T = v^T * A^-1.
+  void update_inverse(const std::vector<T> &x, const std::vector<T> &y, T denom) {
+    const size_type n = size();
+    T              *inv = m_inverse.data();
+    concurrency::parallel_for(0, n, concurrency::grain_for(n),
+                              [inv, &x, &y, denom, n](size_type first, size_type last) {
+                                isa::dispatch([&] {
+                                  for (size_type i = first; i < last; ++i) {
+                                    T coef = x[i] / denom;
+                                    for (size_type j = 0; j < n; ++j) {
+                                      inv[i * n + j] -= coef * y[j];
+                                    }
+                                  }
+                                });
+                              });
+  }
+
+  // Bookkeeping shared by all updates once the matrix itself has been changed.
+  void apply(const std::vector<T> &x, const std::vector<T> &y, T denom) {
+    // The lemma still holds when the denominator is tiny, but the inverse would be garbage.
+    constexpr T tolerance = std::numeric_limits<T>::epsilon() * 1024;
+    if (m_singular || std::abs(denom) <= tolerance || ++m_updates >= m_refactor_period) {
+      refactorize_impl();
+      return;
+    }
+
+    m_det *= denom;
+    update_inverse(x, y, denom);
+  }
+
+  // x = A^-1 * u
+  std::vector<T> solve_right(std::span<const T> u) const {
+    const size_type n = size();
+    std::vector<T>  x(n);
+    for (size_type i = 0; i < n; ++i) {
+      const T *row = m_inverse.data() + i * n;
+      for (size_type k = 0; k < n; ++k) {
+        x[i] += row[k] * u[k];
+      }
+    }
+    return x;
+  }
+
+  // y^T = v^T * A^-1
+  std::vector<T> solve_left(std::span<const T> v) const {
+    const size_type n = size();
+    std::vector<T>  y(n);
+    for (size_type k = 0; k < n; ++k) {
+      const T *row = m_inverse.data() + k * n;
+      for (size_type j = 0; j < n; ++j) {
+        y[j] += v[k] * row[j];
+      }
+    }
+    return y;
+  }
+
+public:
+  static constexpr size_type default_refactor_period = 64;
+
+  updatable_determinant(contiguous_matrix<T> mat, size_type refactor_period = default_refactor_period)
+      : m_mat{std::move(mat)}, m_inverse{m_mat.rows(), m_mat.cols()},
+        m_refactor_period{std::max<size_type>(1, refactor_period)} {
+    if (!m_mat.square() || !m_mat.rows()) throw std::runtime_error("Mismatched matrix size for determinant");
+    refactorize_impl();
+  }
+
+  T                           determinant() const { return m_det; }
+  bool                        singular() const { return m_singular; }
+  const contiguous_matrix<T> &get() const { return m_mat; }
+
+  // Only meaningful while the matrix is not singular.
+  const contiguous_matrix<T> &inverse() const { return m_inverse; }
+
+  // A += u * v^T
+  void rank_one_update(std::span<const T> u, std::span<const T> v) {
+    check_size(u);
+    check_size(v);
+
+    const size_type n = size();
+    for (size_type i = 0; i < n; ++i) {
+      for (size_type j = 0; j < n; ++j) {
+        m_mat.data()[i * n + j] += u[i] * v[j];
+      }
+    }
+    if (m_singular) return apply({}, {}, T{});
+
+    auto x = solve_right(u);
+    auto y = solve_left(v);
+    T    denom = T{1};
+    for (size_type k = 0; k < n; ++k) {
+      denom += v[k] * x[k];
+    }
+    apply(x, y, denom);
+  }
+
+  // Row `row` becomes `values`: u = e_row, v = values - old row. Here A^-1 * u is just a column of the inverse.
+  void replace_row(size_type row, std::span<const T> values) {
+    check_size(values);
+    if (row >= size()) throw std::out_of_range("Row index out of range");
+
+    const size_type n = size();
+    std::vector<T>  v(n);
+    for (size_type j = 0; j < n; ++j) {
+      T &elem = m_mat.data()[row * n + j];
+      v[j] = values[j] - elem;
+      elem = values[j];
+    }
+    if (m_singular) return apply({}, {}, T{});
+
+    std::vector<T> x(n);
+    for (size_type i = 0; i < n; ++i) {
+      x[i] = m_inverse.data()[i * n + row];
+    }
+    auto y = solve_left(v);
+    apply(x, y, T{1} + y[row]);
+  }
+
+  // Column `col` becomes `values`: u = values - old column, v = e_col. Here v^T * A^-1 is just a row of the inverse.
+  void replace_col(size_type col, std::span<const T> values) {
+    check_size(values);
+    if (col >= size()) throw std::out_of_range("Column index out of range");
+
+    const size_type n = size();
+    std::vector<T>  u(n);
+    for (size_type i = 0; i < n; ++i) {
+      T &elem = m_mat.data()[i * n + col];
+      u[i] = values[i] - elem;
+      elem = values[i];
+    }
+    if (m_singular) return apply({}, {}, T{});
+
+    auto           x = solve_right(u);
+    std::vector<T> y(m_inverse.data() + col * n, m_inverse.data() + (col + 1) * n);
+    apply(x, y, T{1} + x[col]);
+  }
+
+  void refactorize() { refactorize_impl(); }
+};
+
+} // namespace linmath
+} // namespace throttle
@@ -10,16 +10,18 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iterator>
+#include <type_traits>
 
 namespace throttle {
 namespace utility {
 
-static inline int clz(unsigned x) { return __builtin_clz(x); }
-static inline int clz(unsigned long x) { return __builtin_clzl(x); }
+static constexpr inline int clz(unsigned x) { return __builtin_clz(x); }
+static constexpr inline int clz(unsigned long x) { return __builtin_clzl(x); }
 
-static inline int ctz(unsigned x) { return __builtin_ctz(x); }
-static inline int ctz(unsigned long x) { return __builtin_ctzl(x); }
+static constexpr inline int ctz(unsigned x) { return __builtin_ctz(x); }
+static constexpr inline int ctz(unsigned long x) { return __builtin_ctzl(x); }
 
 #include <concepts>
 
@@ -37,33 +39,33 @@ private:
   using const_pointer = const T *;
 
 public:
-  contiguous_iterator(pointer ptr = nullptr) : m_ptr{ptr} {}
+  constexpr contiguous_iterator(pointer ptr = nullptr) : m_ptr{ptr} {}
 
   // clang-format off
-  reference operator*() const { return *m_ptr; }
-  pointer operator->() const { return m_ptr; }
+  constexpr reference operator*() const { return *m_ptr; }
+  constexpr pointer operator->() const { return m_ptr; }
 
-  contiguous_iterator &operator++() { m_ptr++; return *this; }
-  contiguous_iterator operator++(int) { contiguous_iterator res{m_ptr}; m_ptr++; return res; }
-  contiguous_iterator &operator--() { m_ptr--; return *this; }
-  contiguous_iterator operator--(int) { contiguous_iterator res{m_ptr}; m_ptr--; return res; }
-  contiguous_iterator &operator+=(difference_type n) { m_ptr += n; return *this; }
-  contiguous_iterator &operator-=(difference_type n) { m_ptr -= n; return *this; }
+  constexpr contiguous_iterator &operator++() { m_ptr++; return *this; }
+  constexpr contiguous_iterator operator++(int) { contiguous_iterator res{m_ptr}; m_ptr++; return res; }
+  constexpr contiguous_iterator &operator--() { m_ptr--; return *this; }
+  constexpr contiguous_iterator operator--(int) { contiguous_iterator res{m_ptr}; m_ptr--; return res; }
+  constexpr contiguous_iterator &operator+=(difference_type n) { m_ptr += n; return *this; }
+  constexpr contiguous_iterator &operator-=(difference_type n) { m_ptr -= n; return *this; }
 
   // clang-format on
-  friend contiguous_iterator operator+(const contiguous_iterator &iter, difference_type n) {
+  friend constexpr contiguous_iterator operator+(const contiguous_iterator &iter, difference_type n) {
     return contiguous_iterator{iter.m_ptr + n};
   }
 
-  friend contiguous_iterator operator+(difference_type n, const contiguous_iterator &iter) {
+  friend constexpr contiguous_iterator operator+(difference_type n, const contiguous_iterator &iter) {
     return contiguous_iterator{iter.m_ptr + n};
   }
 
-  contiguous_iterator operator-(difference_type n) const { return contiguous_iterator{m_ptr - n}; }
-  difference_type     operator-(const contiguous_iterator other) const { return (m_ptr - other.m_ptr); }
-  auto                operator<=>(const contiguous_iterator &) const = default;
+  constexpr contiguous_iterator operator-(difference_type n) const { return contiguous_iterator{m_ptr - n}; }
+  constexpr difference_type     operator-(const contiguous_iterator other) const { return (m_ptr - other.m_ptr); }
+  constexpr auto                operator<=>(const contiguous_iterator &) const = default;
 
-  reference operator[](difference_type n) const { return *(*this + n); }
+  constexpr reference operator[](difference_type n) const { return *(*this + n); }
 };
 
 template <typename T> struct const_contiguous_iterator {
@@ -77,33 +79,81 @@ private:
   pointer m_ptr;
 
 public:
-  const_contiguous_iterator(pointer ptr = nullptr) : m_ptr{ptr} {}
+  constexpr const_contiguous_iterator(pointer ptr = nullptr) : m_ptr{ptr} {}
 
-  reference operator*() const { return *m_ptr; }
-  pointer   operator->() const { return m_ptr; }
+  constexpr reference operator*() const { return *m_ptr; }
+  constexpr pointer   operator->() const { return m_ptr; }
 
   // clang-format off
-  const_contiguous_iterator &operator++() { m_ptr++; return *this; }
-  const_contiguous_iterator operator++(int) { const_contiguous_iterator res{m_ptr}; m_ptr++; return res; }
-  const_contiguous_iterator &operator--() { m_ptr--; return *this; }
-  const_contiguous_iterator operator--(int) { const_contiguous_iterator res{m_ptr}; m_ptr--; return res; }
-  const_contiguous_iterator &operator+=(difference_type n) { m_ptr += n; return *this; }
-  const_contiguous_iterator &operator-=(difference_type n) { m_ptr -= n; return *this; }
+  constexpr const_contiguous_iterator &operator++() { m_ptr++; return *this; }
+  constexpr const_contiguous_iterator operator++(int) { const_contiguous_iterator res{m_ptr}; m_ptr++; return res; }
+  constexpr const_contiguous_iterator &operator--() { m_ptr--; return *this; }
+  constexpr const_contiguous_iterator operator--(int) { const_contiguous_iterator res{m_ptr}; m_ptr--; return res; }
+  constexpr const_contiguous_iterator &operator+=(difference_type n) { m_ptr += n; return *this; }
+  constexpr const_contiguous_iterator &operator-=(difference_type n) { m_ptr -= n; return *this; }
   // clang-format on
 
-  friend const_contiguous_iterator operator+(const const_contiguous_iterator &iter, difference_type n) {
+  friend constexpr const_contiguous_iterator operator+(const const_contiguous_iterator &iter, difference_type n) {
     return contiguous_iterator{iter.m_ptr + n};
   }
 
-  friend const_contiguous_iterator operator+(difference_type n, const const_contiguous_iterator &iter) {
+  friend constexpr const_contiguous_iterator operator+(difference_type n, const const_contiguous_iterator &iter) {
     return contiguous_iterator{iter.m_ptr + n};
   }
 
-  const_contiguous_iterator operator-(difference_type n) const { return contiguous_iterator{m_ptr - n}; }
-  difference_type           operator-(const const_contiguous_iterator other) const { return (m_ptr - other.m_ptr); }
-  auto                      operator<=>(const const_contiguous_iterator &) const = default;
+  constexpr const_contiguous_iterator operator-(difference_type n) const { return contiguous_iterator{m_ptr - n}; }
+  constexpr difference_type           operator-(const const_contiguous_iterator other) const {
+    return (m_ptr - other.m_ptr);
+  }
+  constexpr auto operator<=>(const const_contiguous_iterator &) const = default;
+
+  constexpr reference operator[](difference_type n) const { return *(*this + n); }
+};
+
+// Iterator over elements that are a fixed distance apart in memory, e.g. a column of a row-major buffer. T may be
+// const-qualified to get a read-only iterator.
+template <typename T> struct strided_iterator {
+  using iterator_category = std::random_access_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = std::remove_cv_t<T>;
+  using reference = T &;
+  using pointer = T *;
+
+private:
+  pointer         m_ptr;
+  difference_type m_stride;
+
+public:
+  constexpr strided_iterator(pointer ptr = nullptr, difference_type stride = 1) : m_ptr{ptr}, m_stride{stride} {}
+
+  constexpr reference operator*() const { return *m_ptr; }
+  constexpr pointer   operator->() const { return m_ptr; }
+
+  // clang-format off
+  constexpr strided_iterator &operator++() { m_ptr += m_stride; return *this; }
+  constexpr strided_iterator operator++(int) { strided_iterator res{*this}; m_ptr += m_stride; return res; }
+  constexpr strided_iterator &operator--() { m_ptr -= m_stride; return *this; }
+  constexpr strided_iterator operator--(int) { strided_iterator res{*this}; m_ptr -= m_stride; return res; }
+  constexpr strided_iterator &operator+=(difference_type n) { m_ptr += n * m_stride; return *this; }
+  constexpr strided_iterator &operator-=(difference_type n) { m_ptr -= n * m_stride; return *this; }
+  // clang-format on
+
+  friend constexpr strided_iterator operator+(const strided_iterator &iter, difference_type n) {
+    return strided_iterator{iter.m_ptr + n * iter.m_stride, iter.m_stride};
+  }
+
+  friend constexpr strided_iterator operator+(difference_type n, const strided_iterator &iter) {
+    return strided_iterator{iter.m_ptr + n * iter.m_stride, iter.m_stride};
+  }
+
+  constexpr strided_iterator operator-(difference_type n) const {
+    return strided_iterator{m_ptr - n * m_stride, m_stride};
+  }
+  constexpr difference_type operator-(const strided_iterator other) const { return (m_ptr - other.m_ptr) / m_stride; }
+  constexpr bool            operator==(const strided_iterator &other) const { return m_ptr == other.m_ptr; }
+  constexpr auto            operator<=>(const strided_iterator &other) const { return m_ptr <=> other.m_ptr; }
 
-  reference operator[](difference_type n) const { return *(*this + n); }
+  constexpr reference operator[](difference_type n) const { return *(*this + n); }
 };
 
 } // namespace utility
@@ -29,6 +29,9 @@
 namespace throttle {
 namespace containers {
 
+// Everything is constexpr: storage comes from std::allocator and elements are created with std::construct_at, both of
+// which are allowed in constant evaluation, so a vector may be used while computing a constant as long as it is freed
+// before the evaluation ends. memcpy is only used at run time.
 template <typename T>
 requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
 class vector {
@@ -53,7 +56,42 @@ private:
   using reference = value_type &;
   using const_reference = const value_type &;
 
-  void delete_elements() noexcept {
+  static constexpr pointer allocate(size_type count) { return std::allocator<value_type>{}.allocate(count); }
+
+  static constexpr void deallocate(pointer ptr, size_type count) {
+    if (ptr) std::allocator<value_type>{}.deallocate(ptr, count);
+  }
+
+  // Copy [first, last) into uninitialized storage at dst.
+  static constexpr void copy_construct(const_pointer first, const_pointer last, pointer dst) {
+    if (std::is_constant_evaluated()) {
+      for (; first != last; ++first, ++dst) {
+        std::construct_at(dst, *first);
+      }
+    } else if constexpr (std::is_trivially_copyable_v<value_type>) {
+      std::memcpy(dst, first, (last - first) * sizeof(value_type));
+    } else {
+      std::uninitialized_copy(first, last, dst);
+    }
+  }
+
+  // Move [first, last) into uninitialized storage at dst and destroy the originals. Moves do not throw.
+  static constexpr void relocate(pointer first, pointer last, pointer dst) noexcept {
+    if (std::is_constant_evaluated()) {
+      for (pointer ptr = first; ptr != last; ++ptr, ++dst) {
+        std::construct_at(dst, std::move(*ptr));
+      }
+    } else if constexpr (std::is_trivially_copyable_v<value_type>) {
+      std::memcpy(dst, first, (last - first) * sizeof(value_type));
+      return;
+    } else {
+      std::uninitialized_move(first, last, dst);
+    }
+
+    if constexpr (!std::is_trivially_destructible_v<value_type>) std::destroy(first, last);
+  }
+
+  constexpr void delete_elements() noexcept {
     if constexpr (!std::is_trivially_destructible_v<value_type>) {
       std::destroy(m_buffer_ptr, m_past_end_ptr);
     }
@@ -61,71 +99,65 @@ private:
   }
 
 public:
-  static size_type amortized_buffer_size(size_type x) {
+  static constexpr size_type amortized_buffer_size(size_type x) {
+    if (!x) return 1; // clz(0) is undefined
     return size_type{1} << (CHAR_BIT * sizeof(size_type) - utility::clz(x));
   }
 
 public:
-  vector()
-      : m_buffer_ptr{static_cast<pointer>(::operator new(sizeof(value_type) * default_capacity))},
-        m_past_capacity_ptr{m_buffer_ptr + default_capacity}, m_past_end_ptr{m_buffer_ptr} {}
+  constexpr vector()
+      : m_buffer_ptr{allocate(default_capacity)}, m_past_capacity_ptr{m_buffer_ptr + default_capacity},
+        m_past_end_ptr{m_buffer_ptr} {}
 
-  vector(size_type count, const value_type &value = value_type{}) requires std::copyable<value_type> {
+  constexpr vector(size_type count, const value_type &value = value_type{}) requires std::copyable<value_type> {
     vector temp{};
     temp.reserve(count);
-    ranges::copy(ranges::views::repeat_n(value, count), ranges::back_inserter(temp));
+    for (size_type i = 0; i < count; ++i, ++temp.m_past_end_ptr) {
+      std::construct_at(temp.m_past_end_ptr, value);
+    }
     *this = std::move(temp);
   }
 
-  template <std::input_iterator it> vector(it start, it finish) {
+  template <std::input_iterator it> constexpr vector(it start, it finish) {
     vector temp{};
     std::copy(start, finish, std::back_inserter(temp));
     std::swap(*this, temp);
   }
 
-  template <std::random_access_iterator it> vector(it start, it finish) {
+  template <std::random_access_iterator it> constexpr vector(it start, it finish) {
     vector temp{};
     temp.reserve(std::distance(start, finish));
     std::copy(start, finish, std::back_inserter(temp));
     *this = std::move(temp);
   }
 
-  ~vector() {
-    auto deleter = [](pointer ptr) { ::operator delete(ptr); };
-
-    std::unique_ptr<value_type, decltype(deleter)> uptr{m_buffer_ptr, deleter};
+  constexpr ~vector() {
     delete_elements();
+    deallocate(m_buffer_ptr, capacity());
   }
 
-  vector(vector &&rhs) noexcept {
+  constexpr vector(vector &&rhs) noexcept {
     std::swap(m_buffer_ptr, rhs.m_buffer_ptr);
     std::swap(m_past_capacity_ptr, rhs.m_past_capacity_ptr);
     std::swap(m_past_end_ptr, rhs.m_past_end_ptr);
   }
 
-  vector(const vector &other) requires std::copyable<value_type> {
+  constexpr vector(const vector &other) requires std::copyable<value_type> {
     vector temp{};
     temp.reserve(other.capacity());
-
-    const size_type sz = other.size();
-    if constexpr (std::is_trivially_copyable<value_type>::value) {
-      std::memcpy(temp.m_buffer_ptr, other.m_buffer_ptr, sz * sizeof(value_type));
-    } else {
-      std::uninitialized_copy(other.m_buffer_ptr, other.m_past_end_ptr, temp.m_buffer_ptr);
-    }
-    temp.m_past_end_ptr += sz;
-
+    copy_construct(other.m_buffer_ptr, other.m_past_end_ptr, temp.m_buffer_ptr);
+    temp.m_past_end_ptr += other.size();
     *this = std::move(temp);
   }
 
-  vector &operator=(const vector &rhs) requires std::copyable<value_type> {
+  constexpr vector &operator=(const vector &rhs) requires std::copyable<value_type> {
     if (this == std::addressof(rhs)) return *this;
     vector temp{rhs};
     *this = std::move(temp);
     return *this;
   }
 
-  vector &operator=(vector &&rhs) noexcept {
+  constexpr vector &operator=(vector &&rhs) noexcept {
     if (this == std::addressof(rhs)) return *this;
     std::swap(m_buffer_ptr, rhs.m_buffer_ptr);
     std::swap(m_past_capacity_ptr, rhs.m_past_capacity_ptr);
@@ -133,29 +165,22 @@ public:
     return *this;
   }
 
-  void reserve_exact(size_type cap) {
+  constexpr void reserve_exact(size_type cap) {
     if (cap <= capacity()) return;
 
-    pointer temp_buf = static_cast<pointer>(::operator new(sizeof(value_type) * cap));
-    auto    deleter = [](pointer ptr) { ::operator delete(ptr); };
-    std::unique_ptr<value_type, decltype(deleter)> uptr{temp_buf, deleter};
-
+    pointer         temp_buf = allocate(cap);
     const size_type sz = size();
-    if constexpr (std::is_trivially_copyable<value_type>::value) {
-      std::memcpy(uptr.get(), m_buffer_ptr, sz * sizeof(value_type));
-    } else {
-      std::uninitialized_move(m_buffer_ptr, m_past_end_ptr, uptr.get());
-    }
+    relocate(m_buffer_ptr, m_past_end_ptr, temp_buf);
 
-    ::operator delete(m_buffer_ptr);
-    m_buffer_ptr = uptr.release();
+    deallocate(m_buffer_ptr, capacity());
+    m_buffer_ptr = temp_buf;
     m_past_end_ptr = m_buffer_ptr + sz;
     m_past_capacity_ptr = m_buffer_ptr + cap;
   }
 
-  void reserve(size_type cap) { reserve_exact(amortized_buffer_size(cap)); }
+  constexpr void reserve(size_type cap) { reserve_exact(amortized_buffer_size(cap)); }
 
-  void resize(size_type count, const value_type &val = value_type{}) requires std::copyable<value_type> {
+  constexpr void resize(size_type count, const value_type &val = value_type{}) requires std::copyable<value_type> {
     const size_type sz = size();
     if (count == sz) return;
 
@@ -183,66 +208,68 @@ public:
   }
 
 private:
-  void reserve_if_necessary() {
+  constexpr void reserve_if_necessary() {
     if (m_past_capacity_ptr - m_past_end_ptr > 0) return;
     reserve(capacity());
   }
 
 public:
-  void push_back(const value_type &val) requires std::copyable<value_type> {
+  constexpr void push_back(const value_type &val) requires std::copyable<value_type> {
     reserve_if_necessary();
     value_type tmp{val};
-    new (m_past_end_ptr++) value_type{std::move(tmp)};
+    std::construct_at(m_past_end_ptr, std::move(tmp));
+    m_past_end_ptr++;
   }
 
-  void push_back(value_type &&val) requires std::movable<value_type> {
+  constexpr void push_back(value_type &&val) requires std::movable<value_type> {
     reserve_if_necessary();
-    new (m_past_end_ptr++) value_type{std::move(val)};
+    std::construct_at(m_past_end_ptr, std::move(val));
+    m_past_end_ptr++;
   }
 
-  template <typename... Ts> void emplace_back(Ts &&...args) {
+  template <typename... Ts> constexpr void emplace_back(Ts &&...args) {
     reserve_if_necessary();
-    new (m_past_end_ptr) value_type{(std::forward<Ts>(args))...};
+    std::construct_at(m_past_end_ptr, std::forward<Ts>(args)...);
     m_past_end_ptr++;
   }
 
-  void clear() { delete_elements(); }
-  void pop_back() { std::destroy_at(--m_past_end_ptr); }
+  constexpr void clear() { delete_elements(); }
+  constexpr void pop_back() { std::destroy_at(--m_past_end_ptr); }
 
-  size_type size() const noexcept { return m_past_end_ptr - m_buffer_ptr; }
-  size_type capacity() const noexcept { return m_past_capacity_ptr - m_buffer_ptr; }
+  constexpr size_type size() const noexcept { return m_past_end_ptr - m_buffer_ptr; }
+  constexpr size_type capacity() const noexcept { return m_past_capacity_ptr - m_buffer_ptr; }
 
-  bool empty() const noexcept { return (size() == 0); }
+  constexpr bool empty() const noexcept { return (size() == 0); }
 
-  reference       back() { return *(m_past_end_ptr - 1); }
-  const_reference back() const { return *(m_past_end_ptr - 1); }
+  constexpr reference       back() { return *(m_past_end_ptr - 1); }
+  constexpr const_reference back() const { return *(m_past_end_ptr - 1); }
 
-  reference       front() { return *m_buffer_ptr; }
-  const_reference front() const { return *m_buffer_ptr; }
+  constexpr reference       front() { return *m_buffer_ptr; }
+  constexpr const_reference front() const { return *m_buffer_ptr; }
 
-  value_type       *data() { return m_buffer_ptr; }
-  const value_type *data() const { return m_buffer_ptr; }
+  constexpr value_type       *data() { return m_buffer_ptr; }
+  constexpr const value_type *data() const { return m_buffer_ptr; }
 
-  reference       operator[](size_type index) { return *(m_buffer_ptr + index); }
-  const_reference operator[](size_type index) const { return *(m_buffer_ptr + index); }
+  constexpr reference       operator[](size_type index) { return *(m_buffer_ptr + index); }
+  constexpr const_reference operator[](size_type index) const { return *(m_buffer_ptr + index); }
 
-  reference at(size_type index) {
+  constexpr reference at(size_type index) {
     if (index >= size()) throw std::out_of_range("index out of range.");
     return (*this)[index];
   }
 
-  const_reference at(size_type index) const {
+  constexpr const_reference at(size_type index) const {
     if (index >= size()) throw std::out_of_range("index out of range.");
     return (*this)[index];
   }
 
-  iterator       begin() { return iterator{m_buffer_ptr}; }
-  iterator       end() { return iterator{m_past_end_ptr}; }
-  const_iterator begin() const { return cbegin(); }
-  const_iterator end() const { return cend(); }
+  constexpr iterator       begin() { return iterator{m_buffer_ptr}; }
+  constexpr iterator       end() { return iterator{m_past_end_ptr}; }
+  constexpr const_iterator begin() const { return cbegin(); }
+  constexpr const_iterator end() const { return cend(); }
 
-  const_iterator cbegin() const { return const_iterator{m_buffer_ptr}; }
-  const_iterator cend() const { return const_iterator{m_past_end_ptr}; }
+  constexpr const_iterator cbegin() const { return const_iterator{m_buffer_ptr}; }
+  constexpr const_iterator cend() const { return const_iterator{m_past_end_ptr}; }
 };
 
 } // namespace containers
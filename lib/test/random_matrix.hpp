@@ -0,0 +1,55 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "contiguous_matrix.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// Random test data shared by the unit tests. Entries are uniform in [-1, 1] and drawn in row order, so a given seed
+// always yields the same matrix.
+
+inline std::vector<double> random_values(std::size_t count, std::mt19937 &gen) {
+  std::uniform_real_distribution<double> dist{-1.0, 1.0};
+  std::vector<double>                    res(count);
+  for (auto &v : res)
+    v = dist(gen);
+  return res;
+}
+
+inline throttle::linmath::contiguous_matrix<double> random_matrix(std::size_t rows, std::size_t cols,
+                                                                  std::mt19937 &gen) {
+  auto vals = random_values(rows * cols, gen);
+  return throttle::linmath::contiguous_matrix<double>{rows, cols, vals.begin(), vals.end()};
+}
+
+// Only the lower triangle is drawn, then mirrored.
+inline throttle::linmath::contiguous_matrix<double> random_symmetric(std::size_t n, std::mt19937 &gen) {
+  std::uniform_real_distribution<double>       dist{-1.0, 1.0};
+  throttle::linmath::contiguous_matrix<double> res{n, n};
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j <= i; ++j)
+      res[i][j] = res[j][i] = dist(gen);
+  return res;
+}
+
+inline double max_diff(const throttle::linmath::contiguous_matrix<double> &lhs,
+                       const throttle::linmath::contiguous_matrix<double> &rhs) {
+  double res = 0;
+  for (std::size_t i = 0; i < lhs.rows(); ++i)
+    for (std::size_t j = 0; j < lhs.cols(); ++j)
+      res = std::max(res, std::abs(lhs[i][j] - rhs[i][j]));
+  return res;
+}
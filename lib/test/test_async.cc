@@ -0,0 +1,88 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "async.hpp"
+#include "contiguous_matrix.hpp"
+#include "matrix.hpp"
+
+#include <coroutine>
+#include <future>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace throttle::linmath;
+using namespace throttle::concurrency;
+
+namespace {
+
+// Eagerly started coroutine that publishes its result through a std::promise.
+template <typename T> struct promised_task {
+  struct promise_type {
+    std::promise<T> m_promise;
+
+    promised_task       get_return_object() { return promised_task{m_promise.get_future()}; }
+    std::suspend_never  initial_suspend() noexcept { return {}; }
+    std::suspend_never  final_suspend() noexcept { return {}; }
+    void                return_value(T val) { m_promise.set_value(std::move(val)); }
+    void                unhandled_exception() { m_promise.set_exception(std::current_exception()); }
+  };
+
+  std::future<T> m_result;
+};
+
+promised_task<double> determinant_of_product(matrix<double> a, matrix<double> b, thread_pool &pool) {
+  auto product = co_await co_multiply(std::move(a), std::move(b), pool);
+  co_return co_await co_determinant(std::move(product), pool);
+}
+
+promised_task<int> failing(thread_pool &pool) {
+  co_await spawn_awaitable([] { throw std::runtime_error("failure"); }, pool);
+  co_return 0;
+}
+
+} // namespace
+
+TEST(test_async, test_future) {
+  thread_pool pool{2};
+  auto        future = spawn_future([] { return 42; }, pool);
+  EXPECT_EQ(future.get(), 42);
+
+  auto failed = spawn_future([]() -> int { throw std::runtime_error("failure"); }, pool);
+  EXPECT_THROW(failed.get(), std::runtime_error);
+}
+
+TEST(test_async, test_determinant_async) {
+  thread_pool    pool{2};
+  matrix<double> mat{3, 3, {2, 0, 0, 0, 3, 0, 1, 0, 4}};
+
+  auto future = determinant_async(mat, pool);
+  mat[0][0] = 100; // The task works on its own copy.
+  EXPECT_DOUBLE_EQ(future.get(), 24);
+
+  matrix<long> int_mat{2, 2, {1, 2, 3, 4}};
+  EXPECT_EQ(determinant_async(int_mat, pool).get(), -2);
+}
+
+TEST(test_async, test_multiply_async) {
+  thread_pool             pool{2};
+  contiguous_matrix<int>  a{2, 2, {1, 2, 3, 4}}, b{2, 2, {0, 1, 1, 0}};
+  contiguous_matrix<int>  expected{2, 2, {2, 1, 4, 3}};
+  EXPECT_EQ(multiply_async(a, b, pool).get(), expected);
+}
+
+TEST(test_async, test_coroutine) {
+  thread_pool    pool{2};
+  matrix<double> a{2, 2, {1, 2, 3, 4}}, b{2, 2, {2, 0, 0, 2}};
+
+  auto task = determinant_of_product(a, b, pool);
+  EXPECT_NEAR(task.m_result.get(), -8, 1e-12);
+
+  EXPECT_THROW(failing(pool).m_result.get(), std::runtime_error);
+}
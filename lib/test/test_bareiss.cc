@@ -0,0 +1,83 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "bareiss.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace throttle::linmath;
+
+namespace {
+
+// Plain Bareiss with integer division.
+template <typename T> T reference(std::vector<T> a, std::size_t n) {
+  T    prev{1};
+  bool negate = false;
+  for (std::size_t k = 0; k + 1 < n; ++k) {
+    std::size_t pivot = k;
+    while (pivot < n && a[pivot * n + k] == T{})
+      ++pivot;
+    if (pivot == n) return T{};
+    if (pivot != k) {
+      for (std::size_t j = 0; j < n; ++j)
+        std::swap(a[k * n + j], a[pivot * n + j]);
+      negate = !negate;
+    }
+    for (std::size_t i = k + 1; i < n; ++i) {
+      for (std::size_t j = k + 1; j < n; ++j)
+        a[i * n + j] = (a[k * n + k] * a[i * n + j] - a[i * n + k] * a[k * n + j]) / prev;
+    }
+    prev = a[k * n + k];
+  }
+  return (negate ? -a[n * n - 1] : a[n * n - 1]);
+}
+
+} // namespace
+
+TEST(test_bareiss, test_exact_divisor) {
+  for (std::int64_t d : {1, -1, 2, -2, 3, 7, -12, 64, 1000, -98304, 123456789}) {
+    kernels::exact_divisor<std::int64_t> div{d};
+    for (std::int64_t q : {0, 1, -1, 5, -17, 4096, -123456, 99999999}) {
+      ASSERT_EQ(div.divide(q * d), q) << q << " * " << d;
+    }
+  }
+
+  kernels::exact_divisor<std::int16_t> small{-6};
+  EXPECT_EQ(small.divide(std::int16_t{-30000}), 5000);
+  kernels::exact_divisor<unsigned> unsigned_div{40};
+  EXPECT_EQ(unsigned_div.divide(4000000000u), 100000000u);
+}
+
+TEST(test_bareiss, test_determinant) {
+  std::mt19937                       gen{11};
+  std::uniform_int_distribution<int> dist{-3, 3};
+
+  for (std::size_t n : {1, 2, 5, 9, 12}) {
+    for (int rep = 0; rep < 5; ++rep) {
+      std::vector<std::int64_t> a(n * n);
+      for (auto &v : a)
+        v = dist(gen);
+      if (rep % 2) a[0] = 0;
+      auto expected = reference(a, n);
+      ASSERT_EQ(kernels::bareiss_determinant(a.data(), n), expected) << "n = " << n;
+    }
+  }
+}
+
+TEST(test_bareiss, test_singular) {
+  const std::size_t         n = 10;
+  std::vector<std::int64_t> a(n * n);
+  for (std::size_t i = 0; i < n * n; ++i)
+    a[i] = static_cast<std::int64_t>(i);
+  EXPECT_EQ(kernels::bareiss_determinant(a.data(), n), 0);
+}
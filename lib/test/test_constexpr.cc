@@ -0,0 +1,140 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "contiguous_matrix.hpp"
+#include "matrix.hpp"
+#include "summation.hpp"
+#include "vector.hpp"
+
+#include <array>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace throttle;
+using namespace throttle::linmath;
+
+namespace {
+
+constexpr int vector_sum(int count) {
+  containers::vector<int> vec;
+  for (int i = 0; i < count; ++i)
+    vec.push_back(i);
+  containers::vector<int> copy = vec;
+  copy.resize(count + 1, 100);
+
+  int res = 0;
+  for (int val : copy)
+    res += val;
+  return res;
+}
+
+// Rotation by 90 degrees, composed four times, baked into a table.
+constexpr std::array<int, 4> rotation_power() {
+  contiguous_matrix<int> rot{2, 2, {0, -1, 1, 0}};
+  auto                   res = contiguous_matrix<int>::unity(2);
+  for (int i = 0; i < 4; ++i)
+    res *= rot;
+  return {res[0][0], res[0][1], res[1][0], res[1][1]};
+}
+
+constexpr bool transposes() {
+  contiguous_matrix<int> mat{2, 3, {1, 2, 3, 4, 5, 6}};
+  auto                   col = mat.relayout<column_major>();
+  return transpose(mat) == contiguous_matrix<int>{3, 2, {1, 4, 2, 5, 3, 6}} && col == mat &&
+         mat * transpose(col) == contiguous_matrix<int>{2, 2, {14, 32, 32, 77}};
+}
+
+constexpr long integer_determinant() {
+  contiguous_matrix<long> mat{4, 4, {0, 2, 1, 3, 4, -1, 3, 0, 2, 5, -2, 1, 1, 1, 1, 1}};
+  return determinant(mat);
+}
+
+constexpr double double_determinant() {
+  contiguous_matrix<double, column_major> mat{3, 3, {2, 0, 1, 1, 3, 2, 1, 1, 1}};
+  return determinant(mat);
+}
+
+// L * U with unit lower L and an upper U whose diagonal alternates -1 and 2, with the first two rows swapped, so that
+// the determinant is -(-2)^(n / 2) for even n. The swap leaves a zero in the top left corner to pivot away from.
+template <typename T, matrix_layout L> constexpr contiguous_matrix<T, L> swapped_lu_product(std::size_t n) {
+  contiguous_matrix<T> l{n, n}, u{n, n};
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t j = 0; j < n; ++j) {
+      l[i][j] = (i > j ? T((i + 2 * j) % 3) - 1 : T(i == j));
+      u[i][j] = (i < j ? T((i + j) % 3) - 1 : (i == j ? (i % 2 ? T{2} : T{-1}) : T{}));
+    }
+  }
+
+  auto prod = l * u;
+  contiguous_matrix<T, L> res{n, n};
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      res[i][j] = prod[i < 2 ? 1 - i : i][j];
+  return res;
+}
+
+template <typename T, matrix_layout L = row_major> constexpr T large_determinant(std::size_t n) {
+  return determinant(swapped_lu_product<T, L>(n));
+}
+
+// Filling a tiled matrix with a value leaves its padding zero.
+constexpr bool tiled_fill() {
+  contiguous_matrix<int, tiled<4>> mat{3, 5, 2};
+  return mat.tile_rows() == 1 && mat.tile_cols() == 2 && mat.tile_data(0, 0)[0] == 2 &&
+         mat.tile_data(0, 0)[3 * 4] == 0 && mat.tile_data(0, 1)[0] == 2 && mat.tile_data(0, 1)[1] == 0;
+}
+
+constexpr double compensated_sum() {
+  std::array<double, 3> vals{1e16, 1.0, -1e16};
+  return compensated_summation::sum<double>(vals.size(), [&vals](std::size_t i) { return vals[i]; });
+}
+
+} // namespace
+
+TEST(test_constexpr, test_vector) {
+  static_assert(vector_sum(0) == 100);
+  static_assert(vector_sum(20) == 190 + 100);
+  EXPECT_EQ(vector_sum(20), 290);
+}
+
+TEST(test_constexpr, test_matrix) {
+  static_assert(rotation_power() == std::array{1, 0, 0, 1});
+  static_assert(transposes());
+  EXPECT_TRUE(transposes());
+  static_assert(tiled_fill());
+}
+
+TEST(test_constexpr, test_summation) {
+  static_assert(compensated_sum() == 1.0);
+  EXPECT_EQ(compensated_sum(), 1.0);
+}
+
+TEST(test_constexpr, test_determinant) {
+  constexpr long   det = integer_determinant();
+  constexpr double det_double = double_determinant();
+
+  matrix<long>   expected{4, 4, {0, 2, 1, 3, 4, -1, 3, 0, 2, 5, -2, 1, 1, 1, 1, 1}};
+  matrix<double> expected_double{3, 3, {2, 0, 1, 1, 3, 2, 1, 1, 1}};
+  EXPECT_EQ(det, expected.determinant());
+  EXPECT_NEAR(det_double, expected_double.determinant(), 1e-12);
+
+  // Past the unrolled kernels.
+  static_assert(large_determinant<long>(10) == 32);
+  static_assert(large_determinant<int, column_major>(12) == -64);
+  static_assert(kernels::magnitude(large_determinant<double>(10) - 32.0) < 1e-9);
+  static_assert(kernels::magnitude(large_determinant<double, column_major>(12) + 64.0) < 1e-9);
+  EXPECT_EQ(large_determinant<long>(10), 32);
+  EXPECT_NEAR(large_determinant<double>(10), 32.0, 1e-9);
+  EXPECT_NEAR(large_determinant<double, column_major>(12), -64.0, 1e-9);
+
+  static_assert(determinant(contiguous_matrix<int>{0, 0}) == 1);
+  static_assert(determinant(contiguous_matrix<int>{2, 2, {1, 2, 2, 4}}) == 0);
+  EXPECT_THROW(determinant(contiguous_matrix<int>{2, 3}), std::runtime_error);
+}
@@ -129,4 +129,74 @@ TEST(test_contiguous_matrix, test_multiplication_3) {
   auto C = A * B;
   EXPECT_TRUE(C == matrix(3, 1, {-18, -20, -16}));
   EXPECT_TRUE(A != C);
-}
\ No newline at end of file
+}
+
+using cm_matrix = throttle::linmath::contiguous_matrix<float, throttle::linmath::column_major>;
+
+TEST(test_contiguous_matrix, test_column_major_storage) {
+  cm_matrix a{2, 3, {1, 2, 3, 4, 5, 6}};
+  EXPECT_EQ(a[0][2], 3);
+  EXPECT_EQ(a[1][0], 4);
+
+  std::vector<float> expected{1, 4, 2, 5, 3, 6};
+  EXPECT_TRUE(std::equal(a.begin(), a.end(), expected.begin()));
+  EXPECT_TRUE(a == matrix(2, 3, {1, 2, 3, 4, 5, 6}));
+
+  std::vector<float> fortran{1, 4, 2, 5, 3, 6};
+  EXPECT_EQ(cm_matrix::from_storage(2, 3, fortran.begin(), fortran.end()), a);
+}
+
+TEST(test_contiguous_matrix, test_column_major_proxies) {
+  cm_matrix a{3, 2, {1, 2, 3, 4, 5, 6}};
+
+  std::vector<float> row{3, 4}, col{2, 4, 6};
+  EXPECT_TRUE(std::equal(a[1].begin(), a[1].end(), row.begin()));
+  EXPECT_TRUE(std::equal(a.col(1).begin(), a.col(1).end(), col.begin()));
+
+  a[2][0] = 10;
+  EXPECT_EQ(a.col(0)[2], 10);
+}
+
+TEST(test_contiguous_matrix, test_relayout) {
+  matrix a{3, 4, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}};
+  auto   b = a.relayout<throttle::linmath::column_major>();
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(b.relayout<throttle::linmath::row_major>(), a);
+}
+
+TEST(test_contiguous_matrix, test_transposed_metadata) {
+  matrix a{2, 3, {1, 2, 3, 4, 5, 6}};
+  auto   expected = transpose(a);
+  auto   ptr = a.data();
+  auto   b = std::move(a).transposed();
+
+  EXPECT_EQ(b.rows(), 3);
+  EXPECT_EQ(b.cols(), 2);
+  EXPECT_EQ(b.data(), ptr);
+  EXPECT_EQ(b, expected);
+}
+
+TEST(test_contiguous_matrix, test_column_major_multiplication) {
+  cm_matrix A{2, 3, {1, 2, 3, 4, 5, 6}};
+  matrix    B{3, 2, {7, 8, 9, 10, 11, 12}};
+
+  EXPECT_EQ(A * B, matrix(2, 2, {58, 64, 139, 154}));
+  EXPECT_EQ(B * A, matrix(3, 3, {39, 54, 69, 49, 68, 87, 59, 82, 105}));
+  EXPECT_EQ(A * B.relayout<throttle::linmath::column_major>(), matrix(2, 2, {58, 64, 139, 154}));
+}
+
+TEST(test_contiguous_matrix, test_column_major_transpose) {
+  cm_matrix a{2, 3, {1, 2, 3, 4, 5, 6}};
+  a.transpose();
+  EXPECT_EQ(a, matrix(3, 2, {1, 4, 2, 5, 3, 6}));
+}
+
+TEST(test_contiguous_matrix, test_max_in_col_greater_eq) {
+  matrix    a{4, 2, {1, -2, -7, 3, 5, 8, 7, -8}};
+  cm_matrix b = a.relayout<throttle::linmath::column_major>();
+
+  EXPECT_EQ(a.max_in_col_greater_eq(0, 0), std::make_pair(std::size_t{1}, -7.0f));
+  EXPECT_EQ(b.max_in_col_greater_eq(0, 0), std::make_pair(std::size_t{1}, -7.0f));
+  EXPECT_EQ(a.max_in_col_greater_eq(0, 2), std::make_pair(std::size_t{3}, 7.0f));
+  EXPECT_EQ(b.max_in_col_greater_eq(1, 1), std::make_pair(std::size_t{2}, 8.0f));
+}
@@ -0,0 +1,79 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "contiguous_matrix.hpp"
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace throttle::linmath;
+
+TEST(test_elementwise, test_hadamard) {
+  contiguous_matrix<int> a{2, 2, {1, 2, 3, 4}}, b{2, 2, {5, 6, 7, 8}};
+  EXPECT_EQ(hadamard(a, b), (contiguous_matrix<int>{2, 2, {5, 12, 21, 32}}));
+  EXPECT_THROW(a.hadamard_assign(contiguous_matrix<int>{2, 3}), std::runtime_error);
+
+  contiguous_matrix<int, column_major> col_a{2, 2, {1, 2, 3, 4}}, col_b{2, 2, {5, 6, 7, 8}};
+  EXPECT_EQ(hadamard(col_a, col_b), hadamard(a, b));
+}
+
+TEST(test_elementwise, test_map) {
+  contiguous_matrix<int> a{2, 3, {1, 2, 3, 4, 5, 6}};
+  EXPECT_EQ(map(a, [](int x) { return x * x; }), (contiguous_matrix<int>{2, 3, {1, 4, 9, 16, 25, 36}}));
+  EXPECT_EQ(map(a, a, [](int x, int y) { return x - 2 * y; }),
+            (contiguous_matrix<int>{2, 3, {-1, -2, -3, -4, -5, -6}}));
+
+  // The padding of a tiled matrix stays zero even when f(0) is not, so products over whole tiles are unaffected.
+  contiguous_matrix<int, tiled<4>> t{3, 3, {1, 2, 3, 4, 5, 6, 7, 8, 9}};
+  t.apply([](int x) { return x + 1; });
+  EXPECT_EQ(t, (contiguous_matrix<int>{3, 3, {2, 3, 4, 5, 6, 7, 8, 9, 10}}));
+  for (std::size_t j = 0; j < 4; ++j) {
+    EXPECT_EQ(t.tile_data(0, 0)[3 * 4 + j], 0);
+    EXPECT_EQ(t.tile_data(0, 0)[j * 4 + 3], 0);
+  }
+  EXPECT_EQ((t * contiguous_matrix<int, tiled<4>>::unity(3)), t);
+}
+
+TEST(test_elementwise, test_large) {
+  // Large enough to be split between threads.
+  const std::size_t   rows = 700, cols = 300;
+  std::vector<double> vals(rows * cols);
+  for (std::size_t i = 0; i < vals.size(); ++i)
+    vals[i] = static_cast<double>(i % 1000);
+
+  contiguous_matrix<double> a{rows, cols, vals.begin(), vals.end()}, b = a;
+  b *= 3.0;
+  b -= a;
+  b /= 2.0;
+  b += a;
+  for (std::size_t i = 0; i < rows; ++i)
+    for (std::size_t j = 0; j < cols; ++j)
+      ASSERT_EQ(b[i][j], 2 * vals[i * cols + j]);
+
+  auto squares = hadamard(a, a);
+  for (std::size_t i = 0; i < rows; ++i)
+    for (std::size_t j = 0; j < cols; ++j)
+      ASSERT_EQ(squares[i][j], vals[i * cols + j] * vals[i * cols + j]);
+
+  EXPECT_THROW(a /= 0.0, std::invalid_argument);
+}
+
+TEST(test_elementwise, test_subnormal_divisor) {
+  // The reciprocal of the divisor overflows to infinity, so the division has to be done for real.
+  const double              tiny = std::numeric_limits<double>::denorm_min();
+  contiguous_matrix<double> a{2, 2, {0.0, 1e-320, -1e-300, 0.0}};
+  a /= tiny;
+  EXPECT_EQ(a[0][0], 0.0);
+  EXPECT_EQ(a[0][1], 1e-320 / tiny);
+  EXPECT_EQ(a[1][0], -1e-300 / tiny);
+  EXPECT_EQ(a[1][1], 0.0);
+}
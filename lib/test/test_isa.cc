@@ -0,0 +1,65 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "isa.hpp"
+#include "summation.hpp"
+#include "tile_kernels.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace throttle;
+
+TEST(test_isa, test_parse) {
+  EXPECT_EQ(isa::parse("baseline"), isa::level::baseline);
+  EXPECT_EQ(isa::parse("sse4.2"), isa::level::sse42);
+  EXPECT_EQ(isa::parse("avx2"), isa::level::avx2);
+  EXPECT_EQ(isa::parse("avx512"), isa::level::avx512);
+  EXPECT_FALSE(isa::parse("avx3"));
+  EXPECT_FALSE(isa::parse(""));
+}
+
+TEST(test_isa, test_active) {
+  EXPECT_LE(isa::active(), isa::detect());
+  EXPECT_EQ(isa::active(), isa::active());
+  EXPECT_EQ(isa::dispatch([] { return 42; }), 42);
+}
+
+// Every clone the CPU can run gives the same results as the baseline, up to rounding of contracted multiply-adds.
+TEST(test_isa, test_clones) {
+  constexpr std::size_t                  tile = 32;
+  std::mt19937                           gen{3};
+  std::uniform_real_distribution<double> dist{-1.0, 1.0};
+  std::vector<double>                    a(tile * tile), b(tile * tile);
+  for (auto &v : a)
+    v = dist(gen);
+  for (auto &v : b)
+    v = dist(gen);
+
+  auto product = [&](isa::level at) {
+    std::vector<double> c(tile * tile);
+    isa::run(at, [&] { linmath::kernels::gemm_tile_add(c.data(), a.data(), b.data(), tile, tile, tile, tile); });
+    return c;
+  };
+  auto dot = [&](isa::level at) {
+    return isa::run(at, [&] { return linmath::lane_summation::dot(a.data(), b.data(), a.size()); });
+  };
+
+  const auto expected = product(isa::level::baseline);
+  const auto expected_dot = dot(isa::level::baseline);
+  for (auto at : {isa::level::sse42, isa::level::avx2, isa::level::avx512}) {
+    if (at > isa::detect()) break;
+    auto res = product(at);
+    for (std::size_t i = 0; i < res.size(); ++i)
+      ASSERT_NEAR(res[i], expected[i], 1e-12);
+    EXPECT_NEAR(dot(at), expected_dot, 1e-12);
+  }
+}
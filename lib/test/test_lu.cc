@@ -0,0 +1,99 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "lu.hpp"
+#include "random_matrix.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace throttle::linmath;
+
+namespace {
+
+contiguous_matrix<double> hilbert(std::size_t n) {
+  contiguous_matrix<double> res{n, n};
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      res[i][j] = 1.0 / double(i + j + 1);
+  return res;
+}
+
+// |A|_1 * |A^-1|_1 with the inverse formed column by column.
+double exact_condition(const contiguous_matrix<double> &mat) {
+  const std::size_t        n = mat.rows();
+  lu_decomposition<double> lu{mat};
+
+  auto col_norm = [n](auto &&column_at) {
+    double res = 0;
+    for (std::size_t j = 0; j < n; ++j) {
+      double sum = 0;
+      for (std::size_t i = 0; i < n; ++i)
+        sum += std::abs(column_at(i, j));
+      res = std::max(res, sum);
+    }
+    return res;
+  };
+
+  contiguous_matrix<double> inverse{n, n};
+  for (std::size_t j = 0; j < n; ++j) {
+    std::vector<double> unit(n);
+    unit[j] = 1;
+    auto col = lu.solve(unit);
+    for (std::size_t i = 0; i < n; ++i)
+      inverse[i][j] = col[i];
+  }
+
+  return col_norm([&mat](std::size_t i, std::size_t j) { return mat[i][j]; }) *
+         col_norm([&inverse](std::size_t i, std::size_t j) { return inverse[i][j]; });
+}
+
+} // namespace
+
+TEST(test_lu, test_solve_transposed) {
+  std::mt19937      gen{1};
+  const std::size_t n = 30;
+  auto              mat = random_matrix(n, n, gen);
+
+  lu_decomposition<double> lu{mat};
+  std::vector<double>      b(n);
+  for (std::size_t i = 0; i < n; ++i)
+    b[i] = double(i) - 7.5;
+
+  auto x = b;
+  lu.solve_transposed_in_place(std::span<double>{x});
+  for (std::size_t j = 0; j < n; ++j) {
+    double sum = 0;
+    for (std::size_t i = 0; i < n; ++i)
+      sum += mat[i][j] * x[i];
+    EXPECT_NEAR(sum, b[j], 1e-10);
+  }
+}
+
+TEST(test_lu, test_condition_estimate) {
+  std::mt19937 gen{2};
+
+  std::vector<contiguous_matrix<double>> matrices{random_matrix(5, 5, gen), random_matrix(40, 40, gen),
+                                                  random_matrix(100, 100, gen), hilbert(6), hilbert(10),
+                                                  contiguous_matrix<double>::unity(8)};
+  for (const auto &mat : matrices) {
+    double exact = exact_condition(mat), estimate = lu_decomposition<double>{mat}.condition_estimate();
+    EXPECT_LE(estimate, exact * (1 + 1e-8));
+    EXPECT_GE(estimate, exact / 3);
+  }
+
+  EXPECT_DOUBLE_EQ(lu_decomposition<double>{contiguous_matrix<double>::unity(8)}.condition_estimate(), 1.0);
+
+  contiguous_matrix<double> singular{2, 2, {1, 2, 2, 4}};
+  EXPECT_EQ(lu_decomposition<double>{singular}.condition_estimate(), std::numeric_limits<double>::infinity());
+}
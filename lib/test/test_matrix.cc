@@ -43,6 +43,20 @@ TEST(test_matrix, test_ctor_4) {
   EXPECT_TRUE(A == B);
 }
 
+TEST(test_matrix, test_copy) {
+  matrix A{2, 2, {1, 2, 3, 4}};
+  matrix B = A;
+  B[0][0] = 10;
+  EXPECT_EQ(A[0][0], 1.0f);
+
+  A.convert_to_row_echelon(); // Swaps rows.
+  matrix C{1, 1};
+  C = A;
+  C[0][1] = 5;
+  EXPECT_EQ(C[0][0], A[0][0]);
+  EXPECT_NE(A[0][1], 5.0f);
+}
+
 TEST(test_matrix, test_transponse) {
   std::vector vals{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
 
@@ -76,6 +90,21 @@ TEST(test_matrix, test_sum_2) {
   EXPECT_THROW(A + B, std::runtime_error);
 }
 
+TEST(test_matrix, test_sum_permuted) {
+  matrix A{3, 2, {1, 2, 3, 4, 5, 6}};
+  matrix B{3, 2, {10, 20, 30, 40, 50, 60}};
+  B.swap_rows(0, 2);
+
+  EXPECT_EQ(A + B, (matrix{3, 2, {51, 62, 33, 44, 15, 26}}));
+  EXPECT_EQ(B - A, (matrix{3, 2, {49, 58, 27, 36, 5, 14}}));
+
+  // A swapped copy is still added row by row, not in buffer order.
+  matrix C = B;
+  C += A;
+  EXPECT_EQ(C, A + B);
+  EXPECT_EQ(A + A, (matrix{3, 2, {2, 4, 6, 8, 10, 12}}));
+}
+
 TEST(test_matrix, test_dif_1) {
   matrix A{3, 3, {-1, 2, 3, -3, 1, 4, 5, 3, 2}};
   matrix B{3, 3, {-1, 2, 3, -3, 1, 4, 5, 3, 2}};
@@ -124,6 +153,21 @@ TEST(test_matrix, test_max_in_row) {
   EXPECT_EQ(a.max_in_col(2).second, 12);
 }
 
+TEST(test_matrix, test_max_in_col_greater_eq) {
+  std::vector vals{1, -20, 3, 4, 5, 6, 7, 8, -9, 20, 11, 12, 0, -1, 2, 3, 4, 5, 6, 7, 8, 9, 10, -11, 0, 0, 0, 0, 0, 0};
+  matrix      a(10, 3, vals.begin(), vals.end());
+
+  EXPECT_EQ(a.max_in_col_greater_eq(1, 0).first, 0);
+  EXPECT_EQ(a.max_in_col_greater_eq(1, 0).second, -20);
+  EXPECT_EQ(a.max_in_col_greater_eq(1, 1).first, 3);
+  EXPECT_EQ(a.max_in_col_greater_eq(2, 0).first, 3);
+  EXPECT_EQ(a.max_in_col_greater_eq(0, 4).first, 7);
+  EXPECT_EQ(a.max_in_col_greater_eq(0, 8).first, 8);
+
+  a.swap_rows(0, 9);
+  EXPECT_EQ(a.max_in_col_greater_eq(1, 0).first, 9);
+}
+
 TEST(test_matrix, test_gauss_jordan_elimination_1) {
   matrix A{3, 2, {1, 2, 3, 4, 5, 6}};
   A.convert_to_row_echelon();
@@ -145,4 +189,34 @@ TEST(test_matrix, test_determinant_for_fields_2) {
 TEST(test_matrix, test_determinant_for_fields_3) {
   matrix A{3, 4, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}};
   EXPECT_THROW(A.determinant(), std::runtime_error);
-}
\ No newline at end of file
+}
+// L * U with unit subdiagonal in L, an alternating 1 / -1 diagonal and unit superdiagonal in U, and the first two rows
+// swapped. Its determinant is -(-1)^(n / 2).
+template <typename T> throttle::linmath::matrix<T> swapped_tridiagonal_product(std::size_t n) {
+  auto res = throttle::linmath::matrix<T>::zero(n, n);
+  for (std::size_t i = 0; i < n; ++i) {
+    T diag = (i % 2) ? T{-1} : T{1};
+    res[i][i] += diag;
+    if (i + 1 < n) res[i][i + 1] += T{1};
+    if (i > 0) {
+      res[i][i - 1] += (i - 1) % 2 ? T{-1} : T{1};
+      res[i][i] += T{1};
+    }
+  }
+  res.swap_rows(0, 1);
+  return res;
+}
+
+// Sizes past the unrolled kernels and below the tiled threshold go through the dispatched elimination.
+TEST(test_matrix, test_determinant_elimination) {
+  for (std::size_t n : {9, 10, 40, 101, 200}) {
+    double expected = (n / 2) % 2 ? 1.0 : -1.0;
+    EXPECT_NEAR(swapped_tridiagonal_product<double>(n).determinant(), expected, 1e-9) << "n = " << n;
+    EXPECT_EQ(swapped_tridiagonal_product<long>(n).determinant(), static_cast<long>(expected)) << "n = " << n;
+  }
+
+  auto singular = swapped_tridiagonal_product<double>(40);
+  for (std::size_t j = 0; j < 40; ++j)
+    singular[7][j] = singular[3][j];
+  EXPECT_NEAR(singular.determinant(), 0.0, 1e-9);
+}
@@ -0,0 +1,85 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "lu.hpp"
+#include "mixed_precision.hpp"
+#include "random_matrix.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace throttle::linmath;
+
+TEST(test_mixed_precision, test_lu) {
+  contiguous_matrix<double> a{3, 3, {0, 2, 1, 1, 1, 1, 2, 1, 3}};
+  lu_decomposition<double>  lu{a};
+
+  EXPECT_FALSE(lu.singular());
+  EXPECT_DOUBLE_EQ(lu.determinant(), -3);
+  auto log_det = lu.log_determinant();
+  EXPECT_EQ(log_det.sign, -1);
+  EXPECT_DOUBLE_EQ(log_det.value(), -3);
+
+  std::vector<double> b{3, 3, 6};
+  auto                x = lu.solve(b);
+  for (auto val : x)
+    EXPECT_DOUBLE_EQ(val, 1);
+
+  lu_decomposition<double> singular{contiguous_matrix<double>{2, 2, {1, 2, 2, 4}}};
+  EXPECT_TRUE(singular.singular());
+  EXPECT_EQ(singular.determinant(), 0);
+  EXPECT_EQ(singular.log_determinant().sign, 0);
+}
+
+TEST(test_mixed_precision, test_solve) {
+  const std::size_t n = 80;
+  std::mt19937      gen{1};
+  auto              a = random_matrix(n, n, gen);
+
+  std::vector<double> expected(n), b(n);
+  for (std::size_t i = 0; i < n; ++i)
+    expected[i] = std::sin(double(i));
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t k = 0; k < n; ++k)
+      b[i] += a.data()[i * n + k] * expected[k];
+
+  mixed_precision_options options;
+  options.fallback_to_double = false;
+  auto res = solve_mixed(a, b, options);
+
+  EXPECT_TRUE(res.converged);
+  EXPECT_GT(res.iterations, 0);
+  for (std::size_t i = 0; i < n; ++i)
+    EXPECT_NEAR(res.x[i], expected[i], 1e-12);
+}
+
+TEST(test_mixed_precision, test_determinant) {
+  const std::size_t n = 60;
+  std::mt19937      gen{2};
+  auto              a = random_matrix(n, n, gen);
+  auto              exact = lu_decomposition<double>{a}.log_determinant();
+
+  auto plain = log_determinant_mixed(a);
+  EXPECT_EQ(plain.sign, exact.sign);
+
+  mixed_precision_options options;
+  options.correct_determinant = true;
+  auto corrected = log_determinant_mixed(a, options);
+  EXPECT_EQ(corrected.sign, exact.sign);
+
+  // First order correction removes the float error up to its square.
+  double plain_error = std::abs(plain.log_abs - exact.log_abs);
+  double corrected_error = std::abs(corrected.log_abs - exact.log_abs);
+  EXPECT_LT(corrected_error, 1e-9);
+  EXPECT_LT(corrected_error, plain_error);
+  EXPECT_TRUE(throttle::is_roughly_equal(determinant_mixed(a, options), exact.value(), 1e-9));
+}
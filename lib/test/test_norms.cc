@@ -0,0 +1,133 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "norms.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace throttle::linmath;
+
+TEST(test_norms, test_small) {
+  contiguous_matrix<int> mat{2, 3, {1, -2, 3, -4, 5, -6}};
+
+  EXPECT_EQ(sum(mat), -3);
+  EXPECT_EQ(max_abs(mat), 6);
+  EXPECT_EQ(norm_1(mat), 9);
+  EXPECT_EQ(norm_inf(mat), 15);
+
+  contiguous_matrix<int, column_major> col_mat{2, 3, {1, -2, 3, -4, 5, -6}};
+  EXPECT_EQ(norm_1(col_mat), 9);
+  EXPECT_EQ(norm_inf(col_mat), 15);
+
+  contiguous_matrix<double, tiled<4>> tiled_mat{2, 3, {1, -2, 3, -4, 5, -6}};
+  EXPECT_EQ(sum(tiled_mat), -3.0);
+  EXPECT_EQ(norm_1(tiled_mat), 9.0);
+  EXPECT_EQ(norm_inf(tiled_mat), 15.0);
+  EXPECT_DOUBLE_EQ(norm_frobenius(tiled_mat), std::sqrt(91.0));
+
+  matrix<double> m_mat{2, 2, {1, 2, 3, 4}};
+  EXPECT_EQ(trace(m_mat), 5.0);
+  EXPECT_EQ(norm_1(m_mat), 6.0);
+  EXPECT_EQ(norm_inf(m_mat), 7.0);
+  EXPECT_DOUBLE_EQ(norm_frobenius(m_mat), std::sqrt(30.0));
+  EXPECT_THROW(trace(mat), std::runtime_error);
+
+  EXPECT_EQ(sum(contiguous_matrix<double>{0, 5}), 0.0);
+  EXPECT_EQ(norm_1(contiguous_matrix<double>{3, 0}), 0.0);
+}
+
+TEST(test_norms, test_large) {
+  const std::size_t                      rows = 517, cols = 389;
+  std::mt19937                           gen{1};
+  std::uniform_real_distribution<double> dist{-1.0, 1.0};
+  std::vector<double>                    vals(rows * cols);
+  for (auto &v : vals)
+    v = dist(gen);
+
+  double              total = 0, squares = 0, largest = 0;
+  std::vector<double> row_sums(rows), col_sums(cols);
+  for (std::size_t i = 0; i < rows; ++i) {
+    for (std::size_t j = 0; j < cols; ++j) {
+      double v = vals[i * cols + j];
+      total += v;
+      squares += v * v;
+      largest = std::max(largest, std::abs(v));
+      row_sums[i] += std::abs(v);
+      col_sums[j] += std::abs(v);
+    }
+  }
+  double one = *std::max_element(col_sums.begin(), col_sums.end());
+  double inf = *std::max_element(row_sums.begin(), row_sums.end());
+
+  contiguous_matrix<double>               mat{rows, cols, vals.begin(), vals.end()};
+  contiguous_matrix<double, column_major> col_mat{rows, cols, vals.begin(), vals.end()};
+  contiguous_matrix<double, tiled<>>      tiled_mat{rows, cols, vals.begin(), vals.end()};
+  matrix<double>                          m_mat{rows, cols, vals.begin(), vals.end()};
+
+  EXPECT_NEAR(sum(mat), total, 1e-9);
+  EXPECT_NEAR(sum(col_mat), total, 1e-9);
+  EXPECT_NEAR(sum(tiled_mat), total, 1e-9);
+  EXPECT_NEAR(sum(m_mat), total, 1e-9);
+
+  EXPECT_EQ(max_abs(mat), largest);
+  EXPECT_EQ(max_abs(col_mat), largest);
+  EXPECT_EQ(max_abs(tiled_mat), largest);
+  EXPECT_EQ(max_abs(m_mat), largest);
+
+  for (double norm : {norm_1(mat), norm_1(col_mat), norm_1(tiled_mat), norm_1(m_mat)})
+    EXPECT_NEAR(norm, one, 1e-10);
+  for (double norm : {norm_inf(mat), norm_inf(col_mat), norm_inf(tiled_mat), norm_inf(m_mat)})
+    EXPECT_NEAR(norm, inf, 1e-10);
+  for (double norm : {norm_frobenius(mat), norm_frobenius(col_mat), norm_frobenius(tiled_mat), norm_frobenius(m_mat)})
+    EXPECT_NEAR(norm, std::sqrt(squares), 1e-10);
+
+  // The blocks do not depend on the thread count, so the result is reproducible bit for bit.
+  EXPECT_EQ(sum(mat), sum(contiguous_matrix<double>{mat}));
+}
+
+TEST(test_norms, test_frobenius_range) {
+  const double big = std::numeric_limits<double>::max() / 4, tiny = std::numeric_limits<double>::denorm_min() * 1024;
+
+  contiguous_matrix<double> huge{2, 2, {big, big, big, big}};
+  EXPECT_DOUBLE_EQ(norm_frobenius(huge), 2 * big);
+
+  contiguous_matrix<double> small{2, 2, {tiny, tiny, tiny, tiny}};
+  EXPECT_DOUBLE_EQ(norm_frobenius(small), 2 * tiny);
+
+  EXPECT_EQ(norm_frobenius(contiguous_matrix<double>{3, 3}), 0.0);
+}
+
+TEST(test_norms, test_nan) {
+  // A NaN anywhere, in any lane or block, has to show up in the norm rather than be skipped by a max.
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  for (std::size_t pos : {std::size_t{0}, std::size_t{13}, std::size_t{4 * 300 - 1}}) {
+    contiguous_matrix<double> mat{4, 300, 1.0};
+    mat[pos / 300][pos % 300] = nan;
+    contiguous_matrix<double, column_major> col_mat = mat.relayout<column_major>();
+
+    EXPECT_TRUE(std::isnan(max_abs(mat))) << "pos = " << pos;
+    EXPECT_TRUE(std::isnan(max_abs(col_mat))) << "pos = " << pos;
+    EXPECT_TRUE(std::isnan(norm_1(mat))) << "pos = " << pos;
+    EXPECT_TRUE(std::isnan(norm_1(col_mat))) << "pos = " << pos;
+    EXPECT_TRUE(std::isnan(norm_inf(mat))) << "pos = " << pos;
+    EXPECT_TRUE(std::isnan(norm_inf(col_mat))) << "pos = " << pos;
+    EXPECT_TRUE(std::isnan(norm_frobenius(mat))) << "pos = " << pos;
+  }
+
+  contiguous_matrix<double> zeros{3, 3};
+  zeros[2][1] = nan;
+  EXPECT_TRUE(std::isnan(max_abs(zeros)));
+  EXPECT_TRUE(std::isnan(norm_frobenius(zeros)));
+}
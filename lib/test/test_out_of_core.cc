@@ -0,0 +1,74 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "matrix.hpp"
+#include "out_of_core.hpp"
+#include "random_matrix.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace throttle::linmath;
+
+namespace {
+
+std::filesystem::path write_matrix(const std::vector<double> &vals, const std::string &name) {
+  auto          path = std::filesystem::temp_directory_path() / name;
+  std::ofstream os{path, std::ios::binary};
+  os.write(reinterpret_cast<const char *>(vals.data()), vals.size() * sizeof(double));
+  return path;
+}
+
+} // namespace
+
+TEST(test_out_of_core, test_determinant) {
+  const std::size_t n = 61;
+  std::mt19937      gen{1};
+  auto              vals = random_values(n * n, gen);
+  auto              path = write_matrix(vals, "throttle_test_ooc.bin");
+  double            expected = matrix<double>{n, n, vals.begin(), vals.end()}.determinant();
+
+  // Panels of 1, 7 (uneven last panel) and n columns.
+  for (std::size_t width : {std::size_t{1}, std::size_t{7}, n}) {
+    out_of_core_options options;
+    options.memory_budget = 3 * n * width * sizeof(double);
+    EXPECT_TRUE(throttle::is_roughly_equal(determinant_out_of_core<double>(path, n, options), expected, 1e-9))
+        << "width = " << width;
+  }
+
+  // The input is left alone unless asked otherwise.
+  std::vector<double> after(n * n);
+  std::ifstream{path, std::ios::binary}.read(reinterpret_cast<char *>(after.data()), after.size() * sizeof(double));
+  EXPECT_EQ(after, vals);
+
+  out_of_core_options in_place;
+  in_place.in_place = true;
+  in_place.memory_budget = 3 * n * 8 * sizeof(double);
+  EXPECT_TRUE(throttle::is_roughly_equal(determinant_out_of_core<double>(path, n, in_place), expected, 1e-9));
+
+  std::filesystem::remove(path);
+}
+
+TEST(test_out_of_core, test_singular) {
+  const std::size_t   n = 20;
+  std::vector<double> vals(n * n, 1.0);
+  auto                path = write_matrix(vals, "throttle_test_ooc_singular.bin");
+
+  out_of_core_options options;
+  options.memory_budget = 3 * n * 4 * sizeof(double);
+  EXPECT_EQ(determinant_out_of_core<double>(path, n, options), 0.0);
+  EXPECT_THROW(determinant_out_of_core<double>(path, n + 1), std::runtime_error);
+
+  std::filesystem::remove(path);
+}
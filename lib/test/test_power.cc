@@ -0,0 +1,94 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "power.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace throttle::linmath;
+
+TEST(test_power, test_repeated_product) {
+  const std::size_t                      n = 9;
+  std::mt19937                           gen{1};
+  std::uniform_real_distribution<double> dist{-0.5, 0.5};
+  std::vector<double>                    vals(n * n);
+  for (auto &v : vals)
+    v = dist(gen);
+
+  contiguous_matrix<double> mat{n, n, vals.begin(), vals.end()};
+  auto                      expected = contiguous_matrix<double>::unity(n);
+  for (std::uint64_t k = 0; k <= 21; ++k) {
+    EXPECT_EQ(pow(mat, k), expected) << "k = " << k;
+    expected *= mat;
+  }
+
+  contiguous_matrix<double, column_major> col_mat{n, n, vals.begin(), vals.end()};
+  EXPECT_EQ(pow(col_mat, 12), pow(mat, 12));
+}
+
+TEST(test_power, test_fibonacci) {
+  contiguous_matrix<long> fib{2, 2, {1, 1, 1, 0}};
+  EXPECT_EQ(pow(fib, 90)[0][1], 2880067194370816120L);
+
+  matrix<long> m_fib{2, 2, {1, 1, 1, 0}};
+  EXPECT_EQ(pow(m_fib, 50)[0][1], 12586269025L);
+}
+
+TEST(test_power, test_pow_mod) {
+  const long              mod = 1'000'000'007;
+  contiguous_matrix<long> fib{2, 2, {1, 1, 1, 0}};
+
+  EXPECT_EQ(pow_mod(fib, 1000, mod)[0][1], 517691607);
+  EXPECT_EQ(pow_mod(fib, 90, mod)[0][1], 2880067194370816120L % mod);
+  EXPECT_EQ(pow_mod(fib, 0, 1L), contiguous_matrix<long>::zero(2, 2));
+
+  // Negative entries are reduced into [0, mod): (-1)^3 = -1.
+  contiguous_matrix<long> neg{1, 1, {-1}};
+  EXPECT_EQ(pow_mod(neg, 3, mod)[0][0], mod - 1);
+
+  // A modulus above half the range of a signed type.
+  const int              int_mod = 2'000'000'000;
+  contiguous_matrix<int> neg_int{1, 1, {-1}};
+  EXPECT_EQ(pow_mod(neg_int, 3, int_mod)[0][0], int_mod - 1);
+
+  // Large entries in a large matrix exercise the batched reduction of the dot product.
+  const std::size_t                            n = 40;
+  const std::uint32_t                          big_mod = 4'294'967'291u;
+  std::mt19937                                 gen{1};
+  std::uniform_int_distribution<std::uint64_t> dist{0, big_mod - 1};
+  std::vector<std::uint64_t>                   vals(n * n);
+  for (auto &v : vals)
+    v = dist(gen);
+
+  contiguous_matrix<std::uint64_t> mat{n, n, vals.begin(), vals.end()};
+  auto                             cube = pow_mod(mat, 3, std::uint64_t{big_mod});
+  auto                             square = pow_mod(mat, 2, std::uint64_t{big_mod});
+  for (std::size_t i = 0; i < n; i += 7) {
+    for (std::size_t j = 0; j < n; j += 5) {
+      unsigned __int128 sum = 0;
+      for (std::size_t k = 0; k < n; ++k)
+        sum += (unsigned __int128)square[i][k] * mat[k][j];
+      EXPECT_EQ(cube[i][j], std::uint64_t(sum % big_mod));
+    }
+  }
+}
+
+TEST(test_power, test_errors) {
+  contiguous_matrix<double> rect{2, 3};
+  EXPECT_THROW(pow(rect, 2), std::runtime_error);
+
+  contiguous_matrix<long> fib{2, 2, {1, 1, 1, 0}};
+  EXPECT_THROW(pow_mod(fib, 2, 0L), std::invalid_argument);
+  EXPECT_THROW(pow_mod(fib, 2, (1L << 32) + 2), std::invalid_argument);
+}
@@ -0,0 +1,112 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "qr.hpp"
+#include "random_matrix.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace throttle::linmath;
+
+namespace {
+
+void check_factorization(const contiguous_matrix<double> &mat) {
+  const std::size_t k = std::min(mat.rows(), mat.cols());
+  auto              qr = householder_qr<double>{mat};
+  auto              q = qr.q(), r = qr.r();
+
+  ASSERT_EQ(q.rows(), mat.rows());
+  ASSERT_EQ(q.cols(), k);
+  EXPECT_LT(max_diff(q * r, mat), 1e-12);
+  EXPECT_LT(max_diff(transpose(q) * q, contiguous_matrix<double>::unity(k)), 1e-12);
+  for (std::size_t i = 0; i < r.rows(); ++i)
+    for (std::size_t j = 0; j < i; ++j)
+      EXPECT_EQ(r[i][j], 0.0);
+}
+
+} // namespace
+
+TEST(test_qr, test_factorization) {
+  std::mt19937 gen{1};
+  check_factorization(random_matrix(50, 30, gen));  // Single panel
+  check_factorization(random_matrix(120, 75, gen)); // Several panels, the last one partial
+  check_factorization(random_matrix(40, 100, gen)); // Wide
+  check_factorization(random_matrix(64, 64, gen));  // Square, whole panels
+
+  // A zero column needs no reflector.
+  contiguous_matrix<double> with_zero{3, 2, {0, 1, 0, 2, 0, 3}};
+  check_factorization(with_zero);
+}
+
+TEST(test_qr, test_least_squares) {
+  std::mt19937      gen{2};
+  const std::size_t m = 150, n = 40;
+  auto              mat = random_matrix(m, n, gen);
+
+  // Consistent system: the exact solution comes back.
+  auto                x = random_values(n, gen);
+  std::vector<double> b(m);
+  for (std::size_t i = 0; i < m; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      b[i] += mat[i][j] * x[j];
+
+  auto solved = least_squares(mat, std::span<const double>{b});
+  for (std::size_t j = 0; j < n; ++j)
+    EXPECT_NEAR(solved[j], x[j], 1e-12);
+
+  // Inconsistent system: the residual is orthogonal to the columns.
+  auto noisy = random_values(m, gen);
+  auto fit = least_squares(mat, std::span<const double>{noisy});
+  for (std::size_t j = 0; j < n; ++j) {
+    double dot = 0;
+    for (std::size_t i = 0; i < m; ++i) {
+      double residual = noisy[i];
+      for (std::size_t l = 0; l < n; ++l)
+        residual -= mat[i][l] * fit[l];
+      dot += mat[i][j] * residual;
+    }
+    EXPECT_NEAR(dot, 0.0, 1e-12);
+  }
+
+  contiguous_matrix<double> deficient{3, 2, {1, 2, 2, 4, 3, 6}};
+  std::vector<double>       rhs{1, 2, 3};
+  EXPECT_THROW(qr(deficient).solve(rhs), std::runtime_error);
+  EXPECT_THROW(qr(transpose(deficient)).solve(std::vector<double>{1, 2}), std::runtime_error);
+}
+
+TEST(test_qr, test_tsqr) {
+  std::mt19937      gen{3};
+  const std::size_t m = 3000, n = 12;
+  auto              mat = random_matrix(m, n, gen);
+  auto              b = random_values(m, gen);
+
+  auto direct = householder_qr<double>{mat};
+  for (std::size_t blocks : {1, 2, 5, 1000}) {
+    tsqr<double> tall{mat, blocks};
+
+    // R is unique up to the signs of its rows.
+    auto r = tall.r(), expected = direct.r();
+    for (std::size_t i = 0; i < n; ++i)
+      for (std::size_t j = i; j < n; ++j)
+        EXPECT_NEAR(std::abs(r[i][j]), std::abs(expected[i][j]), 1e-10);
+
+    auto x = tall.solve(b), expected_x = direct.solve(b);
+    for (std::size_t j = 0; j < n; ++j)
+      EXPECT_NEAR(x[j], expected_x[j], 1e-12);
+  }
+
+  auto x = least_squares(mat, std::span<const double>{b}), expected_x = direct.solve(b);
+  for (std::size_t j = 0; j < n; ++j)
+    EXPECT_NEAR(x[j], expected_x[j], 1e-12);
+}
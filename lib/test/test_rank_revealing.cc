@@ -0,0 +1,96 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "rank_revealing.hpp"
+#include "random_matrix.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace throttle::linmath;
+
+namespace {
+
+double max_abs(const contiguous_matrix<double> &mat) {
+  double res = 0;
+  for (auto val : mat)
+    res = std::max(res, std::abs(val));
+  return res;
+}
+
+} // namespace
+
+TEST(test_rank_revealing, test_small) {
+  contiguous_matrix<double> mat{3, 3, {1, 2, 1, 2, 4, 0, 3, 6, 1}};
+  rank_revealing_lu<double> lu{mat};
+
+  EXPECT_EQ(lu.rank(), 2);
+  EXPECT_EQ(lu.nullity(), 1);
+
+  // Complete pivoting starts from the 6 in column 1, the echelon form still has its pivots in columns 0 and 2.
+  contiguous_matrix<double> expected{3, 3, {1, 2, 0, 0, 0, 1, 0, 0, 0}};
+  EXPECT_EQ(lu.rref(), expected);
+
+  auto null = lu.nullspace();
+  ASSERT_EQ(null.rows(), 3);
+  ASSERT_EQ(null.cols(), 1);
+  EXPECT_LT(max_abs(mat * null), 1e-12);
+  EXPECT_GT(max_abs(null), 0.5);
+}
+
+TEST(test_rank_revealing, test_low_rank) {
+  std::mt19937      gen{1};
+  const std::size_t m = 90, n = 70, r = 13;
+  auto              mat = random_matrix(m, r, gen) * random_matrix(r, n, gen);
+
+  rank_revealing_lu<double> lu{mat};
+  EXPECT_EQ(lu.rank(), r);
+
+  auto null = lu.nullspace();
+  ASSERT_EQ(null.rows(), n);
+  ASSERT_EQ(null.cols(), n - r);
+  EXPECT_LT(max_abs(mat * null), 1e-10);
+  EXPECT_EQ(rank(null), n - r);
+
+  // The echelon form has the same row space: stacking it onto the matrix does not raise the rank.
+  auto rref_mat = lu.rref();
+  EXPECT_EQ(rank(rref_mat), r);
+  for (std::size_t i = r; i < m; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      EXPECT_EQ(rref_mat[i][j], 0.0);
+
+  contiguous_matrix<double> stacked{m + r, n};
+  std::copy(mat.begin(), mat.end(), stacked.begin());
+  std::copy(rref_mat.begin(), rref_mat.begin() + r * n, stacked.begin() + m * n);
+  EXPECT_EQ(rank(stacked), r);
+
+  // Wide matrices work the same.
+  EXPECT_EQ(rank(transpose(mat)), r);
+  EXPECT_EQ(nullspace(transpose(mat)).cols(), m - r);
+}
+
+TEST(test_rank_revealing, test_tolerance) {
+  contiguous_matrix<double> mat{3, 3, {1, 0, 0, 0, 1, 0, 0, 0, 1e-12}};
+  EXPECT_EQ(rank(mat), 3);
+  EXPECT_EQ(rank(mat, std::optional{1e-9}), 2);
+
+  contiguous_matrix<double> zero{4, 5};
+  EXPECT_EQ(rank(zero), 0);
+  EXPECT_EQ(nullspace(zero), (contiguous_matrix<double>::unity(5)));
+  EXPECT_EQ(rref(zero), zero);
+
+  std::mt19937 gen{2};
+  auto         full = random_matrix(50, 50, gen);
+  EXPECT_EQ(rank(full), 50);
+  EXPECT_EQ(rref(full), (contiguous_matrix<double>::unity(50)));
+  EXPECT_EQ(nullspace(full).cols(), 0);
+}
@@ -0,0 +1,110 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "contiguous_matrix.hpp"
+#include "matrix.hpp"
+#include "rational.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+using namespace throttle::linmath;
+
+using q64 = rational<std::int64_t>;
+
+static_assert(models_ordered_ring<q64>, "Rational does not model an ordered ring");
+
+TEST(test_rational, test_arithmetic) {
+  q64 a{1, 2}, b{-2, 3};
+  EXPECT_EQ(a + b, q64(-1, 6));
+  EXPECT_EQ(a - b, q64(7, 6));
+  EXPECT_EQ(a * b, q64(-1, 3));
+  EXPECT_EQ(a / b, q64(-3, 4));
+  EXPECT_EQ(-a, q64(1, -2));
+  EXPECT_EQ(q64(6, -4).numerator(), -3);
+  EXPECT_EQ(q64(6, -4).denominator(), 2);
+  EXPECT_EQ(static_cast<double>(q64(3, 8)), 0.375);
+
+  EXPECT_THROW(q64(1, 0), std::invalid_argument);
+  EXPECT_THROW(a / q64{}, std::invalid_argument);
+
+  std::stringstream ss;
+  ss << q64(4, 6) << " " << q64(-8, 4);
+  EXPECT_EQ(ss.str(), "2/3 -2");
+}
+
+TEST(test_rational, test_ordering) {
+  EXPECT_LT(q64(1, 3), q64(1, 2));
+  EXPECT_GT(q64(-1, 3), q64(-1, 2));
+  EXPECT_EQ(q64(2, 4), q64(3, 6));
+  EXPECT_LE(q64(2, 4), q64(1, 2));
+
+  // Too large to cross-multiply.
+  constexpr std::int64_t big = std::numeric_limits<std::int64_t>::max() / 3;
+  EXPECT_LT(q64(big, big - 1), q64(big - 1, big - 2));
+  EXPECT_GT(q64(-big, big - 1), q64(-(big - 1), big - 2));
+  EXPECT_EQ(q64(big, big - 1) <=> q64(big, big - 1), std::strong_ordering::equal);
+}
+
+TEST(test_rational, test_deferred_normalization) {
+  // Numerators and denominators grow unreduced, until reducing is the only way to go on.
+  q64 sum;
+  for (int i = 0; i < 200; ++i) {
+    sum += q64(1, 6);
+  }
+  EXPECT_EQ(sum, q64(100, 3));
+
+  q64 prod{1};
+  for (int i = 0; i < 100; ++i) {
+    prod *= q64(3, 2);
+    prod *= q64(2, 3);
+  }
+  EXPECT_EQ(prod, q64{1});
+
+  constexpr std::int64_t max = std::numeric_limits<std::int64_t>::max();
+  EXPECT_THROW(q64(max) * q64(2), std::overflow_error);
+  EXPECT_THROW(q64(1, max) + q64(1, max - 1), std::overflow_error);
+}
+
+TEST(test_rational, test_determinant) {
+  // Hilbert matrix goes through the unrolled kernels.
+  const std::size_t      small = 5;
+  contiguous_matrix<q64> hilbert{small, small};
+  for (std::size_t i = 0; i < small; ++i) {
+    for (std::size_t j = 0; j < small; ++j)
+      hilbert[i][j] = q64(1, static_cast<std::int64_t>(i + j + 1));
+  }
+  EXPECT_EQ(determinant(hilbert), q64(1, 266716800000));
+
+  // L * U with integer unit lower triangular L and rational upper triangular U with diagonal 1 / (i + 2).
+  const std::size_t      n = 10;
+  contiguous_matrix<q64> lower{n, n}, upper{n, n}, product{n, n};
+  for (std::size_t i = 0; i < n; ++i) {
+    lower[i][i] = 1;
+    upper[i][i] = q64(1, static_cast<std::int64_t>(i + 2));
+    for (std::size_t j = 0; j < i; ++j) {
+      lower[i][j] = static_cast<std::int64_t>((i + j) % 3) - 1;
+      upper[j][i] = q64(static_cast<std::int64_t>((i * j) % 5) - 2, static_cast<std::int64_t>(i + 1));
+    }
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t j = 0; j < n; ++j) {
+      for (std::size_t k = 0; k < n; ++k)
+        product[i][j] += lower[i][k] * upper[k][j];
+    }
+  }
+
+  const q64 expected{1, 39916800}; // 1 / 11!
+  EXPECT_EQ(determinant(product), expected);
+  EXPECT_EQ(matrix<q64>{std::move(product)}.determinant(), expected);
+}
@@ -0,0 +1,96 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "small_determinant.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace throttle::linmath;
+
+namespace {
+
+// Laplace expansion along the first row, exact for integers.
+template <typename T> T reference(const std::vector<T> &a, std::size_t n) {
+  if (n == 1) return a[0];
+
+  T   res{};
+  int sign = 1;
+  for (std::size_t col = 0; col < n; ++col, sign = -sign) {
+    std::vector<T> minor;
+    for (std::size_t i = 1; i < n; ++i) {
+      for (std::size_t j = 0; j < n; ++j) {
+        if (j != col) minor.push_back(a[i * n + j]);
+      }
+    }
+    res += sign * a[col] * reference(minor, n - 1);
+  }
+  return res;
+}
+
+template <typename T> T small(const std::vector<T> &a, std::size_t n) {
+  return kernels::small_determinant<T>(n, [&a, n](std::size_t i, std::size_t j) { return a[i * n + j]; });
+}
+
+} // namespace
+
+TEST(test_small_determinant, test_floating) {
+  std::mt19937                           gen{5};
+  std::uniform_real_distribution<double> dist{-1.0, 1.0};
+
+  for (std::size_t n = 2; n <= kernels::max_small_determinant; ++n) {
+    for (int rep = 0; rep < 20; ++rep) {
+      std::vector<double> a(n * n);
+      for (auto &v : a)
+        v = dist(gen);
+      double expected = reference(a, n);
+      ASSERT_NEAR(small(a, n), expected, 1e-12 * (1 + std::abs(expected))) << "n = " << n;
+    }
+  }
+}
+
+TEST(test_small_determinant, test_integer) {
+  std::mt19937                       gen{7};
+  std::uniform_int_distribution<int> dist{-5, 5};
+
+  for (std::size_t n = 2; n <= kernels::max_small_determinant; ++n) {
+    for (int rep = 0; rep < 20; ++rep) {
+      std::vector<long long> a(n * n);
+      for (auto &v : a)
+        v = dist(gen);
+      // A zero leading element makes Bareiss pivot.
+      if (rep % 2) a[0] = 0;
+      ASSERT_EQ(small(a, n), reference(a, n)) << "n = " << n;
+    }
+  }
+}
+
+TEST(test_small_determinant, test_singular) {
+  for (std::size_t n = 2; n <= kernels::max_small_determinant; ++n) {
+    std::vector<double> a(n * n);
+    for (std::size_t i = 0; i < n * n; ++i)
+      a[i] = static_cast<double>(i % n + 1);
+    EXPECT_EQ(small(a, n), 0.0) << "n = " << n;
+
+    std::vector<int> b(n * n, 0);
+    b[0] = 1;
+    EXPECT_EQ(small(b, n), 0) << "n = " << n;
+  }
+}
+
+TEST(test_small_determinant, test_constexpr) {
+  constexpr int det = kernels::small_determinant<int>(5, [](std::size_t i, std::size_t j) {
+    return (i == j ? 2 : 0) + (j == 4 - i ? 1 : 0);
+  });
+  EXPECT_EQ(det, 3 * 3 * 3 * 1 * 1);
+}
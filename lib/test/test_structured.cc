@@ -0,0 +1,111 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "structured.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace throttle::linmath;
+
+namespace {
+
+template <typename L = row_major> contiguous_matrix<int, L> random_matrix(std::size_t rows, std::size_t cols) {
+  static std::mt19937                gen{1};
+  std::uniform_int_distribution<int> dist{-9, 9};
+  std::vector<int>                   vals(rows * cols);
+  for (auto &v : vals)
+    v = dist(gen);
+  return contiguous_matrix<int, L>{rows, cols, vals.begin(), vals.end()};
+}
+
+template <typename L>
+contiguous_matrix<int, L> naive_kron(const contiguous_matrix<int, L> &a, const contiguous_matrix<int, L> &b) {
+  contiguous_matrix<int, L> res{a.rows() * b.rows(), a.cols() * b.cols()};
+  for (std::size_t i = 0; i < res.rows(); ++i)
+    for (std::size_t j = 0; j < res.cols(); ++j)
+      res[i][j] = a[i / b.rows()][j / b.cols()] * b[i % b.rows()][j % b.cols()];
+  return res;
+}
+
+} // namespace
+
+TEST(test_structured, test_kron) {
+  contiguous_matrix<int> a{2, 2, {1, 2, 3, 4}}, b{1, 2, {0, 5}};
+  EXPECT_EQ(kron(a, b), (contiguous_matrix<int>{2, 4, {0, 5, 0, 10, 0, 15, 0, 20}}));
+
+  auto lhs = random_matrix(7, 5), rhs = random_matrix(4, 9);
+  EXPECT_EQ(kron(lhs, rhs), naive_kron(lhs, rhs));
+
+  auto col_lhs = lhs.relayout<column_major>(), col_rhs = rhs.relayout<column_major>();
+  EXPECT_EQ(kron(col_lhs, col_rhs), naive_kron(lhs, rhs));
+
+  auto tiled_lhs = lhs.relayout<tiled<8>>(), tiled_rhs = rhs.relayout<tiled<8>>();
+  EXPECT_EQ(kron(tiled_lhs, tiled_rhs), naive_kron(lhs, rhs));
+
+  contiguous_matrix<int> wrong{3, 3};
+  EXPECT_THROW(kron_into(wrong, a, b), std::runtime_error);
+}
+
+TEST(test_structured, test_concatenation) {
+  contiguous_matrix<int> a{2, 1, {1, 2}}, b{2, 2, {3, 4, 5, 6}}, c{1, 2, {7, 8}};
+
+  EXPECT_EQ(hcat(a, b), (contiguous_matrix<int>{2, 3, {1, 3, 4, 2, 5, 6}}));
+  EXPECT_EQ(vcat(b, c), (contiguous_matrix<int>{3, 2, {3, 4, 5, 6, 7, 8}}));
+  EXPECT_EQ(block_diag(a, c), (contiguous_matrix<int>{3, 3, {1, 0, 0, 2, 0, 0, 0, 7, 8}}));
+  EXPECT_EQ(hcat(a), a);
+
+  auto col_a = a.relayout<column_major>(), col_b = b.relayout<column_major>(), col_c = c.relayout<column_major>();
+  EXPECT_EQ(hcat(col_a, col_b), hcat(a, b));
+  EXPECT_EQ(vcat(col_b, col_c), vcat(b, c));
+  EXPECT_EQ(block_diag(col_a, col_b, col_c), block_diag(a, b, c));
+
+  auto tiled_a = a.relayout<tiled<2>>(), tiled_b = b.relayout<tiled<2>>(), tiled_c = c.relayout<tiled<2>>();
+  EXPECT_EQ(hcat(tiled_a, tiled_b), hcat(a, b));
+  EXPECT_EQ(block_diag(tiled_a, tiled_b, tiled_c), block_diag(a, b, c));
+
+  EXPECT_THROW(hcat(a, c), std::runtime_error);
+  EXPECT_THROW(vcat(a, b), std::runtime_error);
+}
+
+TEST(test_structured, test_kronecker_view) {
+  std::mt19937                           gen{2};
+  std::uniform_real_distribution<double> dist{-1.0, 1.0};
+  auto                                   random_double = [&](std::size_t rows, std::size_t cols) {
+    std::vector<double> vals(rows * cols);
+    for (auto &v : vals)
+      v = dist(gen);
+    return contiguous_matrix<double>{rows, cols, vals.begin(), vals.end()};
+  };
+
+  auto a = random_double(13, 6), b = random_double(5, 11);
+  auto full = kron(a, b);
+
+  kronecker_view<double> view{a, b};
+  ASSERT_EQ(view.rows(), full.rows());
+  ASSERT_EQ(view.cols(), full.cols());
+  EXPECT_EQ(view(17, 40), full[17][40]);
+
+  std::vector<double> x(view.cols());
+  for (auto &v : x)
+    v = dist(gen);
+
+  auto y = view.multiply(x);
+  for (std::size_t i = 0; i < full.rows(); ++i) {
+    double expected = 0;
+    for (std::size_t j = 0; j < full.cols(); ++j)
+      expected += full[i][j] * x[j];
+    EXPECT_NEAR(y[i], expected, 1e-12);
+  }
+
+  EXPECT_THROW(view.multiply(std::vector<double>(3)), std::runtime_error);
+}
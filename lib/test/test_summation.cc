@@ -0,0 +1,82 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "contiguous_matrix.hpp"
+#include "matrix.hpp"
+#include "summation.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace throttle::linmath;
+
+template <typename P> static float sum_of_tenths(std::size_t n) {
+  return P::template sum<float>(n, [](std::size_t) { return 0.1f; });
+}
+
+TEST(test_summation, test_integers) {
+  std::vector<long> a(1001), b(1001);
+  std::iota(a.begin(), a.end(), -500);
+  std::iota(b.begin(), b.end(), 7);
+  long expected = std::inner_product(a.begin(), a.end(), b.begin(), 0L);
+
+  EXPECT_EQ(sequential_summation::dot(a.data(), b.data(), a.size()), expected);
+  EXPECT_EQ(lane_summation::dot(a.data(), b.data(), a.size()), expected);
+  EXPECT_EQ(pairwise_summation::dot(a.data(), b.data(), a.size()), expected);
+  EXPECT_EQ(compensated_summation::dot(a.data(), b.data(), a.size()), expected);
+  EXPECT_EQ(lane_summation::dot(a.data(), b.data(), 3), a[0] * b[0] + a[1] * b[1] + a[2] * b[2]);
+  EXPECT_EQ(pairwise_summation::dot(a.data(), b.data(), 0), 0);
+}
+
+TEST(test_summation, test_accuracy) {
+  const std::size_t n = 1'000'000;
+  const double      expected = 0.1 * n;
+
+  auto error = [expected](float val) { return std::abs(val - expected) / expected; };
+  float sequential = sum_of_tenths<sequential_summation>(n);
+  float pairwise = sum_of_tenths<pairwise_summation>(n);
+  float compensated = sum_of_tenths<compensated_summation>(n);
+
+  EXPECT_GT(error(sequential), 1e-3);
+  EXPECT_LT(error(pairwise), 1e-6);
+  EXPECT_LT(error(compensated), 1e-6);
+}
+
+TEST(test_summation, test_cancellation) {
+  std::vector<double> a{1e16, 1.0, -1e16, 1.0}, b(4, 1.0);
+  EXPECT_EQ(compensated_summation::dot(a.data(), b.data(), a.size()), 2.0);
+}
+
+TEST(test_summation, test_multiply) {
+  const std::size_t              n = 37, k = 301;
+  std::mt19937                   gen{1};
+  std::uniform_real_distribution dist{-1.0, 1.0};
+  std::vector<double>            lhs_vals(n * k), rhs_vals(k * n);
+  for (auto &v : lhs_vals)
+    v = dist(gen);
+  for (auto &v : rhs_vals)
+    v = dist(gen);
+
+  contiguous_matrix<double> lhs{n, k, lhs_vals.begin(), lhs_vals.end()}, rhs{k, n, rhs_vals.begin(), rhs_vals.end()};
+  auto                      expected = multiply(lhs, rhs, sequential_summation{});
+
+  EXPECT_EQ(lhs * rhs, expected);
+  EXPECT_EQ(multiply(lhs, rhs, pairwise_summation{}), expected);
+  EXPECT_EQ(multiply(lhs, rhs, compensated_summation{}), expected);
+
+  matrix<double> m_lhs{n, k, lhs_vals.begin(), lhs_vals.end()}, m_rhs{k, n, rhs_vals.begin(), rhs_vals.end()};
+  auto           m_res = multiply(m_lhs, m_rhs, compensated_summation{});
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      EXPECT_TRUE(throttle::is_roughly_equal(m_res[i][j], expected[i][j], 1e-12));
+}
@@ -0,0 +1,119 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "symmetric_eigen.hpp"
+#include "random_matrix.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace throttle::linmath;
+
+TEST(test_symmetric_eigen, test_small) {
+  contiguous_matrix<double>     mat{2, 2, {2, 1, 1, 2}};
+  symmetric_eigensolver<double> solver{mat};
+
+  ASSERT_EQ(solver.eigenvalues().size(), 2);
+  EXPECT_NEAR(solver.eigenvalues()[0], 1.0, 1e-15);
+  EXPECT_NEAR(solver.eigenvalues()[1], 3.0, 1e-15);
+
+  const auto &vec = solver.eigenvectors();
+  EXPECT_NEAR(std::abs(vec[0][1]), std::sqrt(0.5), 1e-15);
+  EXPECT_NEAR(vec[0][1], vec[1][1], 1e-15);
+
+  contiguous_matrix<double> diag{3, 3, {3, 0, 0, 0, -1, 0, 0, 0, 2}};
+  EXPECT_EQ(eigenvalues(diag), (std::vector<double>{-1, 2, 3}));
+
+  contiguous_matrix<double> single{1, 1, {5}};
+  EXPECT_EQ(eigenvalues(single), std::vector<double>{5});
+  EXPECT_TRUE(eigenvalues(contiguous_matrix<double>{0, 0}).empty());
+}
+
+TEST(test_symmetric_eigen, test_random) {
+  std::mt19937      gen{1};
+  const std::size_t n = 70;
+  auto              mat = random_symmetric(n, gen);
+
+  symmetric_eigensolver<double> solver{mat};
+  const auto                   &values = solver.eigenvalues();
+  const auto                   &vectors = solver.eigenvectors();
+
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+  EXPECT_LT(max_diff(transpose(vectors) * vectors, contiguous_matrix<double>::unity(n)), 1e-12);
+
+  auto scaled = vectors;
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      scaled[i][j] *= values[j];
+  EXPECT_LT(max_diff(mat * vectors, scaled), 1e-12);
+
+  double trace = 0, sum = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    trace += mat[i][i];
+    sum += values[i];
+  }
+  EXPECT_NEAR(trace, sum, 1e-12);
+
+  auto only_values = eigenvalues(mat);
+  for (std::size_t i = 0; i < n; ++i)
+    EXPECT_NEAR(only_values[i], values[i], 1e-12);
+
+  // Only the lower triangle is read.
+  auto lower = mat;
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = i + 1; j < n; ++j)
+      lower[i][j] = 0;
+  EXPECT_EQ(eigenvalues(lower), only_values);
+}
+
+TEST(test_symmetric_eigen, test_degenerate) {
+  // Repeated eigenvalues still give an orthonormal basis: I + u * u^T has eigenvalue 1 n - 1 times.
+  const std::size_t         n = 40;
+  contiguous_matrix<double> mat = contiguous_matrix<double>::unity(n);
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      mat[i][j] += 1.0 / n;
+
+  symmetric_eigensolver<double> solver{mat};
+  for (std::size_t i = 0; i + 1 < n; ++i)
+    EXPECT_NEAR(solver.eigenvalues()[i], 1.0, 1e-13);
+  EXPECT_NEAR(solver.eigenvalues()[n - 1], 2.0, 1e-13);
+
+  const auto &vectors = solver.eigenvectors();
+  EXPECT_LT(max_diff(transpose(vectors) * vectors, contiguous_matrix<double>::unity(n)), 1e-12);
+
+  symmetric_eigensolver<double> no_vectors{mat, false};
+  EXPECT_THROW(no_vectors.eigenvectors(), std::runtime_error);
+  EXPECT_THROW(symmetric_eigensolver<double>{contiguous_matrix<double>(2, 3)}, std::runtime_error);
+}
+
+TEST(test_symmetric_eigen, test_blocked) {
+  // Several panels, and blocks on the diagonal so that many reflectors are the identity.
+  std::mt19937      gen{2};
+  const std::size_t n = 150, block = 10;
+  auto              mat = random_symmetric(n, gen);
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      if (i / block != j / block) mat[i][j] = 0;
+
+  symmetric_eigensolver<double> solver{mat};
+  const auto                   &values = solver.eigenvalues();
+  const auto                   &vectors = solver.eigenvectors();
+  EXPECT_LT(max_diff(transpose(vectors) * vectors, contiguous_matrix<double>::unity(n)), 1e-12);
+
+  auto scaled = vectors;
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      scaled[i][j] *= values[j];
+  EXPECT_LT(max_diff(mat * vectors, scaled), 1e-12);
+}
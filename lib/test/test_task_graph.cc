@@ -0,0 +1,100 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "task_graph.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace throttle::concurrency;
+
+TEST(test_task_graph, test_order) {
+  thread_pool pool{4};
+  task_graph  graph;
+
+  std::mutex       mutex;
+  std::vector<int> order;
+  auto             record = [&](int i) {
+    return [&, i] {
+      std::lock_guard lock{mutex};
+      order.push_back(i);
+    };
+  };
+
+  // Diamond: 0 -> {1, 2} -> 3
+  auto a = graph.add(record(0)), b = graph.add(record(1)), c = graph.add(record(2)), d = graph.add(record(3));
+  graph.precede(a, b);
+  graph.precede(a, c);
+  graph.precede(b, d);
+  graph.precede(c, d);
+
+  for (int run = 0; run < 10; ++run) {
+    order.clear();
+    graph.run(pool);
+    ASSERT_EQ(order.size(), 4);
+    EXPECT_EQ(order.front(), 0);
+    EXPECT_EQ(order.back(), 3);
+  }
+}
+
+TEST(test_task_graph, test_chain) {
+  thread_pool pool{2};
+  task_graph  graph;
+
+  int  value = 0;
+  auto prev = graph.add([&] { value = 1; });
+  for (int i = 0; i < 100; ++i) {
+    auto next = graph.add([&] { value *= 2; value %= 1000007; });
+    graph.precede(prev, next);
+    prev = next;
+  }
+
+  graph.run(pool);
+
+  int expected = 1;
+  for (int i = 0; i < 100; ++i)
+    expected = expected * 2 % 1000007;
+  EXPECT_EQ(value, expected);
+}
+
+TEST(test_task_graph, test_exception) {
+  thread_pool      pool{2};
+  task_graph       graph;
+  std::atomic<int> executed = 0;
+
+  auto first = graph.add([] { throw std::runtime_error("failure"); });
+  auto second = graph.add([&] { ++executed; });
+  graph.precede(first, second);
+
+  EXPECT_THROW(graph.run(pool), std::runtime_error);
+  EXPECT_EQ(executed, 0);
+}
+
+TEST(test_task_graph, test_nested_on_single_thread) {
+  // Inner graph waits on the same single worker that runs the outer task.
+  thread_pool pool{1};
+  task_graph  outer;
+  int         value = 0;
+
+  outer.add([&] {
+    task_graph inner;
+    auto       a = inner.add([&] { value += 1; });
+    auto       b = inner.add([&] { value *= 10; });
+    inner.precede(a, b);
+    inner.run(pool);
+  });
+
+  outer.run(pool);
+  EXPECT_EQ(value, 10);
+}
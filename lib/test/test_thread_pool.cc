@@ -0,0 +1,178 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace throttle::concurrency;
+
+TEST(test_thread_pool, test_deque_owner) {
+  work_stealing_deque<int> deque{2};
+  EXPECT_TRUE(deque.empty());
+  EXPECT_FALSE(deque.pop());
+
+  // Grows past the initial capacity.
+  for (int i = 0; i < 100; ++i)
+    deque.push(i);
+
+  EXPECT_EQ(deque.steal(), 0);
+  EXPECT_EQ(deque.pop(), 99);
+  EXPECT_EQ(deque.steal(), 1);
+  for (int i = 98; i >= 2; --i)
+    EXPECT_EQ(deque.pop(), i);
+  EXPECT_FALSE(deque.pop());
+  EXPECT_FALSE(deque.steal());
+}
+
+TEST(test_thread_pool, test_deque_concurrent_steal) {
+  constexpr int             count = 100000;
+  work_stealing_deque<int>  deque{16};
+  std::vector<int>          taken(count, 0);
+  std::atomic<int>          total = 0;
+  std::atomic<bool>         done = false;
+  std::vector<std::thread>  thieves;
+
+  for (int t = 0; t < 3; ++t) {
+    thieves.emplace_back([&] {
+      while (!done || !deque.empty()) {
+        if (auto val = deque.steal()) {
+          ++taken[*val];
+          ++total;
+        }
+      }
+    });
+  }
+
+  for (int i = 0; i < count; ++i) {
+    deque.push(i);
+    if (i % 3 == 0) {
+      if (auto val = deque.pop()) {
+        ++taken[*val];
+        ++total;
+      }
+    }
+  }
+  done = true;
+  for (auto &t : thieves)
+    t.join();
+
+  EXPECT_EQ(total, count);
+  for (int i = 0; i < count; ++i)
+    ASSERT_EQ(taken[i], 1) << "element " << i;
+}
+
+TEST(test_thread_pool, test_submit) {
+  thread_pool      pool{thread_pool_config{3}};
+  std::atomic<int> counter = 0;
+  constexpr int    count = 10000;
+
+  EXPECT_EQ(pool.size(), 3);
+  for (int i = 0; i < count; ++i) {
+    pool.submit([&] {
+      if (counter.fetch_add(1) + 1 == count) pool.notify();
+    });
+  }
+
+  pool.wait_until([&] { return counter.load() == count; });
+  EXPECT_EQ(counter, count);
+}
+
+TEST(test_thread_pool, test_nested_submit) {
+  // Tasks spawned from workers land in their own deques and get stolen from there.
+  thread_pool      pool{4};
+  std::atomic<int> counter = 0;
+
+  for (int i = 0; i < 16; ++i) {
+    pool.submit([&] {
+      for (int j = 0; j < 64; ++j) {
+        pool.submit([&] {
+          if (counter.fetch_add(1) + 1 == 16 * 64) pool.notify();
+        });
+      }
+    });
+  }
+
+  pool.wait_until([&] { return counter.load() == 16 * 64; });
+  EXPECT_EQ(counter, 16 * 64);
+}
+
+TEST(test_thread_pool, test_parallel_for) {
+  thread_pool              pool{4};
+  constexpr std::size_t    count = 100003;
+  std::vector<int>         visited(count, 0);
+  std::atomic<std::size_t> calls = 0;
+
+  parallel_for(
+      3, count, 100,
+      [&](std::size_t first, std::size_t last) {
+        EXPECT_LT(first, last);
+        ++calls;
+        for (std::size_t i = first; i < last; ++i)
+          ++visited[i];
+      },
+      pool);
+
+  EXPECT_GT(calls, 1);
+  for (std::size_t i = 0; i < count; ++i)
+    ASSERT_EQ(visited[i], i >= 3 ? 1 : 0) << "index " << i;
+}
+
+TEST(test_thread_pool, test_parallel_for_small) {
+  thread_pool pool{2};
+  int         calls = 0;
+
+  parallel_for(0, 10, 16, [&](std::size_t first, std::size_t last) {
+    ++calls;
+    EXPECT_EQ(first, 0);
+    EXPECT_EQ(last, 10);
+  }, pool);
+  parallel_for(5, 5, 1, [&](std::size_t, std::size_t) { ++calls; }, pool);
+
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(test_thread_pool, test_parallel_for_exception) {
+  thread_pool      pool{2};
+  std::atomic<int> visited = 0;
+
+  EXPECT_THROW(parallel_for(
+                   0, 1000, 10,
+                   [&](std::size_t first, std::size_t last) {
+                     visited += static_cast<int>(last - first);
+                     if (first == 0) throw std::runtime_error("failure");
+                   },
+                   pool),
+               std::runtime_error);
+  EXPECT_EQ(visited, 1000);
+}
+
+TEST(test_thread_pool, test_parallel_for_nested) {
+  thread_pool      pool{1};
+  std::atomic<int> sum = 0;
+
+  parallel_for(0, 8, 1, [&](std::size_t first, std::size_t last) {
+    for (std::size_t i = first; i < last; ++i) {
+      parallel_for(0, 100, 10, [&](std::size_t lo, std::size_t hi) { sum += static_cast<int>(hi - lo); }, pool);
+    }
+  }, pool);
+
+  EXPECT_EQ(sum, 800);
+}
+
+TEST(test_thread_pool, test_configure) {
+  EXPECT_GE(thread_pool::instance().size(), 1);
+  EXPECT_FALSE(thread_pool::configure(thread_pool_config{2}));
+}
@@ -0,0 +1,155 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "matrix.hpp"
+#include "tiled.hpp"
+#include "random_matrix.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace throttle::linmath;
+
+using tiled_mat = tiled_matrix<double, 8>;
+using dense_mat = contiguous_matrix<double>;
+
+TEST(test_tiled, test_storage) {
+  tiled_mat a{3, 10, 1.0};
+  EXPECT_EQ(a.tile_rows(), 1);
+  EXPECT_EQ(a.tile_cols(), 2);
+  EXPECT_EQ(std::distance(a.begin(), a.end()), 2 * 64);
+
+  // Padding stays zero even when filling with a value.
+  EXPECT_EQ(a.tile_data(0, 0)[0], 1.0);
+  EXPECT_EQ(a.tile_data(0, 1)[1], 1.0);
+  EXPECT_EQ(a.tile_data(0, 1)[2], 0.0);
+  EXPECT_EQ(a.tile_data(0, 0)[3 * 8], 0.0);
+}
+
+TEST(test_tiled, test_proxies) {
+  std::mt19937 gen{1};
+  auto         vals = random_values(11 * 13, gen);
+  dense_mat    a{11, 13, vals.begin(), vals.end()};
+  tiled_mat    b{11, 13, vals.begin(), vals.end()};
+
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(b.relayout<row_major>(), a);
+  EXPECT_EQ(a.relayout<tiled<8>>(), b);
+
+  b[10][12] = 42;
+  EXPECT_EQ(b.col(12)[10], 42);
+  EXPECT_EQ(b.max_in_col_greater_eq(12, 0).first, 10);
+}
+
+TEST(test_tiled, test_tile_iteration) {
+  tiled_mat   a{20, 9};
+  std::size_t count = 0;
+  for (auto tile : a.tiles()) {
+    EXPECT_EQ(tile.data, a.tile_data(tile.tile_row, tile.tile_col));
+    ++count;
+  }
+  EXPECT_EQ(count, 6);
+}
+
+TEST(test_tiled, test_transpose) {
+  std::mt19937 gen{2};
+  auto         vals = random_values(11 * 19, gen);
+  dense_mat    a{11, 19, vals.begin(), vals.end()};
+  tiled_mat    b{11, 19, vals.begin(), vals.end()};
+  EXPECT_EQ(transpose(b), transpose(a));
+}
+
+TEST(test_tiled, test_multiplication) {
+  std::mt19937 gen{3};
+  auto         lhs = random_values(17 * 10, gen), rhs = random_values(10 * 21, gen);
+  dense_mat    a{17, 10, lhs.begin(), lhs.end()}, b{10, 21, rhs.begin(), rhs.end()};
+  tiled_mat    c{17, 10, lhs.begin(), lhs.end()}, d{10, 21, rhs.begin(), rhs.end()};
+  EXPECT_EQ(c * d, a * b);
+}
+
+TEST(test_tiled, test_determinant) {
+  std::mt19937 gen{4};
+  for (std::size_t n : {1, 5, 8, 16, 29}) {
+    auto           vals = random_values(n * n, gen);
+    matrix<double> a{n, n, vals.begin(), vals.end()};
+    tiled_mat      b{n, n, vals.begin(), vals.end()};
+    EXPECT_TRUE(throttle::is_roughly_equal(determinant(b), a.determinant(), 1e-9)) << "n = " << n;
+  }
+}
+
+TEST(test_tiled, test_determinant_singular) {
+  tiled_mat a{12, 12, 1.0};
+  EXPECT_EQ(determinant(a), 0.0);
+  EXPECT_EQ(determinant(tiled_mat::unity(20)), 1.0);
+}
+
+TEST(test_tiled, test_determinant_task_graph) {
+  const std::size_t n = 45;
+  std::mt19937      gen{5};
+  auto              vals = random_values(n * n, gen);
+  matrix<double>    a{n, n, vals.begin(), vals.end()};
+
+  throttle::concurrency::thread_pool pool{3};
+  tiled_mat                          b{n, n, vals.begin(), vals.end()};
+  EXPECT_TRUE(throttle::is_roughly_equal(tiled_determinant(b, pool), a.determinant(), 1e-9));
+  EXPECT_EQ(determinant(b), tiled_determinant(b));
+}
+
+TEST(test_tiled, test_matrix_dispatch) {
+  // A = L * U with unit L, so det(A) is the product of the diagonal of U.
+  const std::size_t n = 300;
+  std::mt19937      gen{6};
+  auto              vals = random_values(2 * n * n, gen);
+  matrix<double>    l = matrix<double>::unity(n), u = matrix<double>::zero(n, n);
+  double            expected = 1;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t j = 0; j < i; ++j)
+      l[i][j] = vals[i * n + j] * 0.05;
+    for (std::size_t j = i + 1; j < n; ++j)
+      u[i][j] = vals[n * n + i * n + j] * 0.05;
+    u[i][i] = 1.0 + vals[i * n + i] * 0.1;
+    expected *= u[i][i];
+  }
+
+  auto a = l * u;
+  a.swap_rows(0, 1);
+  EXPECT_TRUE(throttle::is_roughly_equal(a.determinant(), -expected, 1e-7));
+}
+
+TEST(test_tiled, test_cholesky) {
+  // B * B^T + n * I is symmetric positive definite.
+  const std::size_t n = 27;
+  std::mt19937      gen{7};
+  auto              vals = random_values(n * n, gen);
+  dense_mat         b{n, n, vals.begin(), vals.end()};
+  dense_mat         spd = b * transpose(b) + dense_mat::unity(n) * double(n);
+
+  // Only the lower triangle is referenced, so the upper one may hold anything and is left alone.
+  tiled_mat factor = spd.relayout<tiled<8>>();
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = i + 1; j < n; ++j)
+      factor[i][j] = -1.0;
+  ASSERT_TRUE(cholesky(factor));
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = i + 1; j < n; ++j)
+      ASSERT_EQ(factor[i][j], -1.0);
+
+  dense_mat l{n, n};
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j <= i; ++j)
+      l[i][j] = factor[i][j];
+
+  EXPECT_EQ(l * transpose(l), spd);
+
+  tiled_mat not_spd = (dense_mat::unity(n) * -1.0).relayout<tiled<8>>();
+  EXPECT_FALSE(cholesky(not_spd));
+}
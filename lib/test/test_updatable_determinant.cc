@@ -0,0 +1,73 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "matrix.hpp"
+#include "updatable_determinant.hpp"
+#include "random_matrix.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace throttle::linmath;
+
+namespace {
+
+double reference(const contiguous_matrix<double> &mat) {
+  return matrix<double>{contiguous_matrix<double>{mat}}.determinant();
+}
+
+} // namespace
+
+TEST(test_updatable_determinant, test_updates) {
+  const std::size_t n = 12;
+  std::mt19937      gen{1};
+  auto              vals = random_values(n * n, gen);
+
+  // Period larger than the number of updates, so everything goes through Sherman-Morrison.
+  updatable_determinant<double> det{contiguous_matrix<double>{n, n, vals.begin(), vals.end()}, 1000};
+  EXPECT_TRUE(throttle::is_roughly_equal(det.determinant(), reference(det.get()), 1e-9));
+
+  for (std::size_t step = 0; step < 30; ++step) {
+    auto values = random_values(n, gen);
+    switch (step % 3) {
+    case 0: det.replace_row(step % n, values); break;
+    case 1: det.replace_col((step * 5) % n, values); break;
+    case 2: det.rank_one_update(values, random_values(n, gen)); break;
+    }
+    ASSERT_TRUE(throttle::is_roughly_equal(det.determinant(), reference(det.get()), 1e-8)) << "step " << step;
+  }
+
+  auto product = det.get() * det.inverse();
+  EXPECT_EQ(product, contiguous_matrix<double>::unity(n));
+}
+
+TEST(test_updatable_determinant, test_singular) {
+  // Entries are chosen so that elimination is exact.
+  contiguous_matrix<double>     a{3, 3, {2, 1, 0, 0, 4, 0, 1, 1, 1}};
+  updatable_determinant<double> det{a, 2};
+  EXPECT_TRUE(throttle::is_roughly_equal(det.determinant(), 8.0));
+
+  // Third row becomes the sum of the first two.
+  std::vector<double> sum{2, 5, 0};
+  det.replace_row(2, sum);
+  EXPECT_TRUE(det.singular());
+  EXPECT_EQ(det.determinant(), 0.0);
+
+  std::vector<double> col{0, 0, 1};
+  det.replace_col(2, col);
+  EXPECT_FALSE(det.singular());
+  EXPECT_TRUE(throttle::is_roughly_equal(det.determinant(), reference(det.get())));
+
+  std::vector<double> short_vec{1, 2};
+  EXPECT_THROW(det.replace_row(0, short_vec), std::runtime_error);
+  EXPECT_THROW(det.replace_row(3, sum), std::out_of_range);
+}
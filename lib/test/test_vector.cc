@@ -63,6 +63,14 @@ TEST(test_vector, test_reserve_1) {
   EXPECT_EQ(a.size(), 0);
 }
 
+TEST(test_vector, test_reserve_0) {
+  vector a(0, 1);
+  EXPECT_EQ(a.size(), 0);
+  a.reserve(0);
+  a.push_back(3);
+  EXPECT_EQ(a[0], 3);
+}
+
 TEST(test_vector, test_reserve_2) {
   vector a;
   a.reserve(7);
@@ -0,0 +1,150 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "protocol.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <boost/program_options.hpp>
+#include <boost/program_options/option.hpp>
+
+namespace po = boost::program_options;
+
+// Reads a matrix in the same format as `determinant` does and asks a running `determinant --serve` for the answer.
+
+template <typename T> bool pack_binary(std::size_t count, std::string &payload) {
+  std::vector<T> elements(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (!(std::cin >> elements[i])) {
+      std::cout << "Can't read " << i << "-th element";
+      return false;
+    }
+  }
+  payload.assign(reinterpret_cast<const char *>(elements.data()), count * sizeof(T));
+  return true;
+}
+
+bool pack_payload(const protocol::request_header &header, std::string &payload) {
+  std::size_t count = std::size_t{header.size} * header.size;
+
+  if (header.format == protocol::payload_format::binary) {
+    switch (header.type) {
+    case protocol::element_type::int_type: return pack_binary<int>(count, payload);
+    case protocol::element_type::long_type: return pack_binary<long>(count, payload);
+    case protocol::element_type::float_type: return pack_binary<float>(count, payload);
+    case protocol::element_type::double_type: return pack_binary<double>(count, payload);
+    }
+  }
+
+  // Text is forwarded as is and parsed by the server.
+  std::string token;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (!(std::cin >> token)) {
+      std::cout << "Can't read " << i << "-th element";
+      return false;
+    }
+    payload += token;
+    payload += ' ';
+  }
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  std::string             socket_path, type_name;
+  unsigned                repeat = 1;
+  po::options_description desc("Available options");
+  desc.add_options()("help,h", "Print this help message")("measure,m", "Print mean round trip time")(
+      "socket,s", po::value<std::string>(&socket_path)->required(), "Path of the server socket")(
+      "type,t", po::value<std::string>(&type_name)->default_value("double"),
+      "Type for matrix element (int, long, float, double)")("binary,b", "Send elements in binary form")(
+      "repeat,r", po::value<unsigned>(&repeat)->default_value(1), "Send the same request this many times");
+
+  po::variables_map vm;
+  po::store(po::parse_command_line(argc, argv, desc), vm);
+
+  if (vm.count("help")) {
+    std::cout << desc << "\n";
+    return 1;
+  }
+
+  po::notify(vm);
+
+  protocol::request_header header;
+  auto                     type = protocol::parse_element_type(type_name);
+  if (!type) {
+    std::cout << "Unknown element type " << type_name << "\n";
+    return 1;
+  }
+  header.type = *type;
+  header.format = (vm.count("binary") ? protocol::payload_format::binary : protocol::payload_format::text);
+
+  long n;
+  if (!(std::cin >> n) || n <= 0) {
+    std::cout << "Invalid matrix size\n";
+    return 1;
+  }
+  header.size = static_cast<std::uint32_t>(n);
+
+  std::string payload;
+  if (!pack_payload(header, payload)) return 1;
+  if (payload.size() > protocol::max_payload_size) {
+    std::cout << "Matrix is too large for the server\n";
+    return 1;
+  }
+  header.payload_size = static_cast<std::uint32_t>(payload.size());
+
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+  if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+    std::cout << "Can't connect to " << socket_path << ": " << std::strerror(errno) << "\n";
+    return 1;
+  }
+
+  protocol::response_header response;
+  std::string               answer;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (unsigned i = 0; i < repeat; ++i) {
+    if (!protocol::write_all(fd, &header, sizeof(header)) || !protocol::write_all(fd, payload.data(), payload.size()) ||
+        !protocol::read_all(fd, &response, sizeof(response)) || response.magic != protocol::response_magic) {
+      std::cout << "Connection to server lost\n";
+      return 1;
+    }
+    answer.resize(response.payload_size);
+    if (!protocol::read_all(fd, answer.data(), answer.size())) {
+      std::cout << "Connection to server lost\n";
+      return 1;
+    }
+  }
+  auto finish = std::chrono::high_resolution_clock::now();
+  ::close(fd);
+
+  if (response.code != protocol::status::ok) {
+    std::cout << answer << "\n";
+    return 1;
+  }
+
+  std::cout << answer;
+
+  if (vm.count("measure") && repeat) {
+    auto elapsed = std::chrono::duration<double, std::micro>(finish - start);
+    std::cout << "request took " << elapsed.count() / repeat << "us to complete on average\n";
+  }
+}
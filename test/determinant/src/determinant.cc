@@ -6,10 +6,15 @@
 #include <string>
 
 #include "contiguous_matrix.hpp"
+#include "lu.hpp"
 #include "matrix.hpp"
+#include "mixed_precision.hpp"
+#include "out_of_core.hpp"
+#include "server.hpp"
 #include "vector.hpp"
 
 #include <concepts>
+#include <filesystem>
 #include <optional>
 #include <string>
 
@@ -49,14 +54,109 @@ template <typename T> bool main_loop_determinant(unsigned n, bool measure = fals
   return true;
 }
 
+// Factorize in float and correct in double; with --measure also time a double factorization and report the error.
+bool main_loop_mixed(unsigned n, bool correct, bool measure = false) {
+  throttle::linmath::contiguous_matrix<double> m{n, n};
+
+  for (unsigned i = 0; i < n * n; ++i) {
+    if (!(std::cin >> m.data()[i])) {
+      std::cout << "Can't read " << i << "-th element";
+      return false;
+    }
+  }
+
+  throttle::linmath::mixed_precision_options options;
+  options.correct_determinant = correct;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  auto det = throttle::linmath::log_determinant_mixed(m, options);
+  auto finish = std::chrono::high_resolution_clock::now();
+  auto elapsed = std::chrono::duration<double, std::milli>(finish - start);
+
+  std::cout << std::fixed << det.value() << "\n";
+
+  if (measure) {
+    auto start_double = std::chrono::high_resolution_clock::now();
+    auto reference = throttle::linmath::lu_decomposition<double>{m}.log_determinant();
+    auto finish_double = std::chrono::high_resolution_clock::now();
+    auto elapsed_double = std::chrono::duration<double, std::milli>(finish_double - start_double);
+
+    std::cout << "mixed precision determinant took " << elapsed.count() << "ms to run\n";
+    std::cout << "double precision determinant took " << elapsed_double.count() << "ms to run\n";
+    std::cout << std::scientific << "relative error of the determinant: "
+              << std::abs(std::expm1(det.log_abs - reference.log_abs))
+              << (det.sign == reference.sign ? "" : " (wrong sign)") << "\n";
+  }
+
+  return true;
+}
+
+// Determinant and an estimate of the 1-norm condition number from the same LU factorization.
+template <std::floating_point T> bool main_loop_condition(unsigned n, bool measure = false) {
+  throttle::linmath::contiguous_matrix<T> m{n, n};
+
+  for (unsigned i = 0; i < n * n; ++i) {
+    if (!(std::cin >> m.data()[i])) {
+      std::cout << "Can't read " << i << "-th element";
+      return false;
+    }
+  }
+
+  auto start = std::chrono::high_resolution_clock::now();
+  auto lu = throttle::linmath::lu_decomposition<T>{std::move(m)};
+  auto det = lu.determinant();
+  auto factorized = std::chrono::high_resolution_clock::now();
+  auto condition = lu.condition_estimate();
+  auto finish = std::chrono::high_resolution_clock::now();
+
+  std::cout << std::fixed << det << "\n";
+  std::cout << std::scientific << "condition number estimate: " << condition << "\n";
+
+  if (measure) {
+    std::cout << std::fixed << "determinant calculation took "
+              << std::chrono::duration<double, std::milli>(factorized - start).count() << "ms to run\n";
+    std::cout << "condition estimate took " << std::chrono::duration<double, std::milli>(finish - factorized).count()
+              << "ms to run\n";
+  }
+
+  return true;
+}
+
+template <std::floating_point T> bool determinant_from_file(const std::string &path, bool measure = false) {
+  std::size_t n = std::llround(std::sqrt(std::filesystem::file_size(path) / sizeof(T)));
+
+  auto start = std::chrono::high_resolution_clock::now();
+  auto det = throttle::linmath::determinant_out_of_core<T>(path, n);
+  auto finish = std::chrono::high_resolution_clock::now();
+  auto elapsed = std::chrono::duration<double, std::milli>(finish - start);
+
+  std::cout << std::fixed << det << "\n";
+
+  if (measure) {
+    std::cout << "determinant calculation took " << elapsed.count() << "ms to run\n";
+  }
+
+  return true;
+}
+
 int main(int argc, char *argv[]) {
-  bool measure = false;
+  bool     measure = false;
+  unsigned idle_timeout = 30;
 
-  std::string             opt;
+  std::string             opt, socket_path, file_path;
   po::options_description desc("Available options");
   desc.add_options()("help,h", "Print this help message")("measure,m", "Print perfomance metrics")(
       "type,t", po::value<std::string>(&opt)->default_value("double"),
-      "Type for matrix element (int, long, float, double)");
+      "Type for matrix element (int, long, float, double)")(
+      "serve,s", po::value<std::string>(&socket_path),
+      "Keep running and answer requests on a Unix domain socket at the given path")(
+      "idle-timeout", po::value<unsigned>(&idle_timeout)->default_value(30),
+      "With --serve, close connections that send nothing for this many seconds (0 never does)")(
+      "file,f", po::value<std::string>(&file_path),
+      "Read n * n raw elements (row by row, float or double) from a binary file and factorize it out of core")(
+      "mixed", "Factorize in float, with --measure compare against double")(
+      "correct", "Apply the first order correction of the float determinant in --mixed mode")(
+      "condition", "Also print an estimate of the 1-norm condition number (float or double)");
 
   po::variables_map vm;
   po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -69,6 +169,22 @@ int main(int argc, char *argv[]) {
 
   measure = vm.count("measure");
 
+  if (vm.count("serve")) {
+    return serve(socket_path, idle_timeout);
+  }
+
+  if (vm.count("file")) {
+    try {
+      if (opt == "float") return !determinant_from_file<float>(file_path, measure);
+      if (opt == "double") return !determinant_from_file<double>(file_path, measure);
+    } catch (std::exception &e) {
+      std::cout << e.what() << "\n";
+      return 1;
+    }
+    std::cout << "Out of core determinant needs a floating point type\n";
+    return 1;
+  }
+
   std::string n_str;
 
   if (!(std::cin >> n_str)) {
@@ -89,7 +205,14 @@ int main(int argc, char *argv[]) {
     return 1;
   }
 
-  if (opt == "int") {
+  if (vm.count("mixed")) {
+    if (!main_loop_mixed(n, vm.count("correct"), measure)) return 1;
+  } else if (vm.count("condition")) {
+    if (opt == "float") return !main_loop_condition<float>(n, measure);
+    if (opt == "double") return !main_loop_condition<double>(n, measure);
+    std::cout << "Condition estimate needs a floating point type\n";
+    return 1;
+  } else if (opt == "int") {
     if (!main_loop_determinant<int>(n, measure)) return 1;
   } else if (opt == "long") {
     if (!main_loop_determinant<long>(n, measure)) return 1;
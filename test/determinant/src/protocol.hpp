@@ -0,0 +1,96 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Framing used by `determinant --serve` and `determinant_client`. Both ends live on the same host, so headers are sent
+// in native byte order. A request is a request_header followed by payload_size bytes: either the n * n elements as
+// whitespace separated text, or packed elements of the given type in native representation. Every request gets a
+// response_header followed by the determinant as text (formatted like the driver prints it) or an error message.
+namespace protocol {
+
+inline constexpr std::uint32_t request_magic = 0x51544452;  // "RDTQ"
+inline constexpr std::uint32_t response_magic = 0x53544452; // "RDTS"
+// A text payload of this size can still describe a matrix of about twice as many bytes, e.g. 64 MiB of short numbers
+// give a 4096 x 4096 matrix of doubles, which is plenty for this driver.
+inline constexpr std::uint32_t max_payload_size = std::uint32_t{1} << 26;
+
+enum class payload_format : std::uint8_t { text = 0, binary = 1 };
+enum class element_type : std::uint8_t { int_type = 0, long_type = 1, float_type = 2, double_type = 3 };
+enum class status : std::uint32_t { ok = 0, error = 1 };
+
+struct request_header {
+  std::uint32_t  magic = request_magic;
+  payload_format format = payload_format::text;
+  element_type   type = element_type::double_type;
+  std::uint16_t  reserved = 0;
+  std::uint32_t  size = 0;
+  std::uint32_t  payload_size = 0;
+};
+
+struct response_header {
+  std::uint32_t magic = response_magic;
+  status        code = status::ok;
+  std::uint32_t payload_size = 0;
+};
+
+inline std::optional<element_type> parse_element_type(std::string_view name) {
+  if (name == "int") return element_type::int_type;
+  if (name == "long") return element_type::long_type;
+  if (name == "float") return element_type::float_type;
+  if (name == "double") return element_type::double_type;
+  return std::nullopt;
+}
+
+inline std::size_t element_size(element_type type) {
+  switch (type) {
+  case element_type::int_type: return sizeof(int);
+  case element_type::long_type: return sizeof(long);
+  case element_type::float_type: return sizeof(float);
+  case element_type::double_type: return sizeof(double);
+  }
+  return 0;
+}
+
+// Blocking helpers that retry short transfers. They return false on error or when the peer has closed the connection.
+inline bool read_all(int fd, void *buf, std::size_t len) {
+  auto *pos = static_cast<char *>(buf);
+  while (len) {
+    ssize_t got = ::read(fd, pos, len);
+    if (got < 0 && errno == EINTR) continue;
+    if (got <= 0) return false;
+    pos += got;
+    len -= static_cast<std::size_t>(got);
+  }
+  return true;
+}
+
+inline bool write_all(int fd, const void *buf, std::size_t len) {
+  const auto *pos = static_cast<const char *>(buf);
+  while (len) {
+    ssize_t sent = ::send(fd, pos, len, MSG_NOSIGNAL);
+    if (sent < 0 && errno == EINTR) continue;
+    if (sent <= 0) return false;
+    pos += sent;
+    len -= static_cast<std::size_t>(sent);
+  }
+  return true;
+}
+
+} // namespace protocol
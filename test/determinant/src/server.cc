@@ -0,0 +1,193 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#include "server.hpp"
+#include "protocol.hpp"
+
+#include "matrix.hpp"
+#include "thread_pool.hpp"
+
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <semaphore>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+char socket_path[sizeof(sockaddr_un::sun_path)];
+char staging_socket_path[sizeof(sockaddr_un::sun_path)];
+
+extern "C" void remove_socket_and_exit(int) {
+  ::unlink(staging_socket_path);
+  ::unlink(socket_path);
+  ::_exit(0);
+}
+
+// Every connection can hold a payload and a matrix built from it at the same time, so their number is what bounds the
+// memory of the server. Further clients wait in the listen backlog until a slot frees up, and connections that go idle
+// are closed after a timeout so that they cannot hold on to a slot forever.
+constexpr std::ptrdiff_t  max_connections = 4;
+std::counting_semaphore<> connection_slots{max_connections};
+
+// The matrix is allocated from the untrusted size, so the payload has to be able to hold it first: n * n elements in
+// binary, or n * n numbers separated by at least one character each as text.
+template <typename T> void check_payload_size(const protocol::request_header &header, std::size_t payload_size) {
+  const std::size_t n = header.size;
+  std::size_t       elements, needed;
+  if (__builtin_mul_overflow(n, n, &elements)) throw std::runtime_error("Invalid matrix size");
+
+  if (header.format == protocol::payload_format::binary) {
+    if (__builtin_mul_overflow(elements, sizeof(T), &needed) || payload_size != needed) {
+      throw std::runtime_error("Payload size does not match matrix size");
+    }
+  } else if (__builtin_mul_overflow(elements, std::size_t{2}, &needed) || payload_size < needed - 1) {
+    throw std::runtime_error("Payload is too short for matrix size");
+  }
+}
+
+template <typename T> std::string compute(const protocol::request_header &header, const std::string &payload) {
+  check_payload_size<T>(header, payload.size());
+
+  const std::size_t            n = header.size;
+  throttle::linmath::matrix<T> m{n, n};
+
+  if (header.format == protocol::payload_format::binary) {
+    for (std::size_t i = 0; i < n; ++i) {
+      std::memcpy(&m[i][0], payload.data() + i * n * sizeof(T), n * sizeof(T));
+    }
+  } else {
+    std::istringstream is{payload};
+    for (std::size_t i = 0; i < n * n; ++i) {
+      if (!(is >> m[i / n][i % n])) throw std::runtime_error("Can't read " + std::to_string(i) + "-th element");
+    }
+  }
+
+  std::ostringstream os;
+  if constexpr (std::is_floating_point_v<T>) {
+    os << std::fixed;
+  }
+  os << m.determinant() << "\n";
+  return os.str();
+}
+
+std::string compute(const protocol::request_header &header, const std::string &payload) {
+  if (!header.size) throw std::runtime_error("Invalid matrix size");
+
+  switch (header.type) {
+  case protocol::element_type::int_type: return compute<int>(header, payload);
+  case protocol::element_type::long_type: return compute<long>(header, payload);
+  case protocol::element_type::float_type: return compute<float>(header, payload);
+  case protocol::element_type::double_type: return compute<double>(header, payload);
+  }
+  throw std::runtime_error("Unknown element type");
+}
+
+void serve_connection(int fd) {
+  protocol::request_header header;
+  std::string              payload;
+
+  while (protocol::read_all(fd, &header, sizeof(header))) {
+    if (header.magic != protocol::request_magic || header.payload_size > protocol::max_payload_size) break;
+
+    payload.resize(header.payload_size);
+    if (!protocol::read_all(fd, payload.data(), payload.size())) break;
+
+    protocol::response_header response;
+    std::string               answer;
+    try {
+      answer = compute(header, payload);
+    } catch (std::exception &e) {
+      response.code = protocol::status::error;
+      answer = e.what();
+    }
+
+    response.payload_size = static_cast<std::uint32_t>(answer.size());
+    if (!protocol::write_all(fd, &response, sizeof(response)) || !protocol::write_all(fd, answer.data(), answer.size()))
+      break;
+  }
+
+  ::close(fd);
+  connection_slots.release();
+}
+
+} // namespace
+
+int serve(const std::string &path, unsigned idle_timeout_seconds) {
+  // The socket file appears on bind(), before listen(), and a client that connects in between is refused. Binding to
+  // a private name and renaming it afterwards makes the socket show up only once it accepts connections.
+  const std::string staging_path = path + "." + std::to_string(::getpid());
+  if (staging_path.size() >= sizeof(socket_path)) {
+    std::cout << "Socket path is too long\n";
+    return 1;
+  }
+
+  std::strcpy(socket_path, path.c_str());
+  std::strcpy(staging_socket_path, staging_path.c_str());
+
+  int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener < 0) {
+    std::cout << "Can't create socket: " << std::strerror(errno) << "\n";
+    return 1;
+  }
+
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  std::strcpy(addr.sun_path, staging_path.c_str());
+  ::unlink(addr.sun_path);
+
+  // Before bind(), so that a signal at any point afterwards removes whichever name the socket has by then.
+  std::signal(SIGINT, remove_socket_and_exit);
+  std::signal(SIGTERM, remove_socket_and_exit);
+
+  if (::bind(listener, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 || ::listen(listener, SOMAXCONN) < 0 ||
+      ::rename(addr.sun_path, socket_path) < 0) {
+    std::cout << "Can't listen on " << path << ": " << std::strerror(errno) << "\n";
+    ::unlink(addr.sun_path);
+    ::close(listener);
+    return 1;
+  }
+
+  // Start the workers now rather than on the first large request.
+  throttle::concurrency::thread_pool::instance();
+
+  for (;;) {
+    connection_slots.acquire();
+    int fd = ::accept(listener, nullptr, nullptr);
+    if (fd < 0) {
+      int error = errno;
+      connection_slots.release();
+      if (error == EINTR || error == ECONNABORTED) continue;
+      std::cout << "accept failed: " << std::strerror(error) << "\n";
+      break;
+    }
+
+    // Reads that time out fail like a closed connection, which ends serve_connection.
+    timeval timeout{};
+    timeout.tv_sec = idle_timeout_seconds;
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    std::thread{serve_connection, fd}.detach();
+  }
+
+  ::close(listener);
+  ::unlink(socket_path);
+  return 1;
+}
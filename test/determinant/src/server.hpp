@@ -0,0 +1,19 @@
+/*
+ * ----------------------------------------------------------------------------
+ * "THE BEER-WARE LICENSE" (Revision 42):
+ * <tsimmerman.ss@phystech.edu>, <alex.rom23@mail.ru> wrote this file.  As long as you
+ * retain this notice you can do whatever you want with this stuff. If we meet
+ * some day, and you think this stuff is worth it, you can buy us a beer in
+ * return.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <string>
+
+// Listen on a Unix domain socket at `path` and answer determinant requests (see protocol.hpp) until terminated.
+// Every connection is served by its own thread and may send any number of requests; large matrices are computed on
+// the library thread pool, which is started up front. Only a few connections are served at once, and one that sends
+// nothing for `idle_timeout_seconds` is closed to make room for others. Returns a non-zero exit code on setup failure.
+int serve(const std::string &path, unsigned idle_timeout_seconds = 30);
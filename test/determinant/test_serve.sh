@@ -0,0 +1,66 @@
+# Same answers as test.sh, but through `determinant --serve` and the client, in text and binary form.
+current_folder=${2:-./}
+base_folder="resources"
+passed=true
+
+# ASCII colors
+red=`tput setaf 1`
+green=`tput setaf 2`
+reset=`tput sgr0`
+
+work_dir=`mktemp -d`
+socket="$work_dir/determinant.sock"
+
+$1 --serve $socket --idle-timeout 1 &
+server=$!
+trap "kill $server; rm -rf $work_dir" EXIT
+
+for i in `seq 50`; do
+  [ -S $socket ] && break
+  sleep 0.1
+done
+
+cd $current_folder/$base_folder
+
+for file in *.dat; do
+  for mode in "" "--binary"; do
+    echo -n "Testing $green$file$reset $mode ..."
+    $4 --socket $socket $mode < $file > $work_dir/ans.tmp
+    filename="${file}.ans"
+
+    if $3 $filename $work_dir/ans.tmp; then
+      echo "${green}Passed${reset}"
+    else
+      echo "${red}Failed${reset}"
+      passed=false
+    fi
+  done
+done
+
+# More idle clients than the server serves at once must not lock out a real one: idle connections are closed.
+python3 -c "
+import socket, sys, time
+clients = [socket.socket(socket.AF_UNIX) for _ in range(6)]
+for c in clients:
+    c.connect(sys.argv[1])
+time.sleep(30)
+" $socket &
+idle=$!
+sleep 0.5
+
+file=`ls *.dat | head -n 1`
+echo -n "Testing $green$file$reset behind idle clients ..."
+if timeout 20 $4 --socket $socket < $file > $work_dir/ans.tmp && $3 ${file}.ans $work_dir/ans.tmp; then
+  echo "${green}Passed${reset}"
+else
+  echo "${red}Failed${reset}"
+  passed=false
+fi
+kill $idle
+
+if ${passed}
+then
+  exit 0
+else
+  exit 666
+fi